@@ -25,6 +25,7 @@ static const char* LockService_method_names[] = {
   "/dscc.LockService/Ping",
   "/dscc.LockService/AcquireGuard",
   "/dscc.LockService/ReleaseGuard",
+  "/dscc.LockService/RenewLease",
 };
 
 std::unique_ptr< LockService::Stub> LockService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -37,6 +38,7 @@ LockService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channe
   : channel_(channel), rpcmethod_Ping_(LockService_method_names[0], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_AcquireGuard_(LockService_method_names[1], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_ReleaseGuard_(LockService_method_names[2], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_RenewLease_(LockService_method_names[3], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   {}
 
 ::grpc::Status LockService::Stub::Ping(::grpc::ClientContext* context, const ::dscc::PingRequest& request, ::dscc::PingResponse* response) {
@@ -108,6 +110,29 @@ void LockService::Stub::async::ReleaseGuard(::grpc::ClientContext* context, cons
   return result;
 }
 
+::grpc::Status LockService::Stub::RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::dscc::RenewLeaseResponse* response) {
+  return ::grpc::internal::BlockingUnaryCall< ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), rpcmethod_RenewLease_, context, request, response);
+}
+
+void LockService::Stub::async::RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, std::function<void(::grpc::Status)> f) {
+  ::grpc::internal::CallbackUnaryCall< ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_RenewLease_, context, request, response, std::move(f));
+}
+
+void LockService::Stub::async::RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, ::grpc::ClientUnaryReactor* reactor) {
+  ::grpc::internal::ClientCallbackUnaryFactory::Create< ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_RenewLease_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>* LockService::Stub::PrepareAsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncResponseReaderHelper::Create< ::dscc::RenewLeaseResponse, ::dscc::RenewLeaseRequest, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), cq, rpcmethod_RenewLease_, context, request);
+}
+
+::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>* LockService::Stub::AsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+  auto* result =
+    this->PrepareAsyncRenewLeaseRaw(context, request, cq);
+  result->StartCall();
+  return result;
+}
+
 LockService::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       LockService_method_names[0],
@@ -139,6 +164,16 @@ LockService::Service::Service() {
              ::dscc::ReleaseResponse* resp) {
                return service->ReleaseGuard(ctx, req, resp);
              }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      LockService_method_names[3],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< LockService::Service, ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(
+          [](LockService::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::dscc::RenewLeaseRequest* req,
+             ::dscc::RenewLeaseResponse* resp) {
+               return service->RenewLease(ctx, req, resp);
+             }, this)));
 }
 
 LockService::Service::~Service() {
@@ -165,6 +200,13 @@ LockService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status LockService::Service::RenewLease(::grpc::ServerContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace dscc
 
@@ -56,6 +56,13 @@ class LockService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::ReleaseResponse>> PrepareAsyncReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::ReleaseResponse>>(PrepareAsyncReleaseGuardRaw(context, request, cq));
     }
+    virtual ::grpc::Status RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::dscc::RenewLeaseResponse* response) = 0;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>> AsyncRenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>>(AsyncRenewLeaseRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>> PrepareAsyncRenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>>(PrepareAsyncRenewLeaseRaw(context, request, cq));
+    }
     class async_interface {
      public:
       virtual ~async_interface() {}
@@ -65,6 +72,8 @@ class LockService final {
       virtual void AcquireGuard(::grpc::ClientContext* context, const ::dscc::AcquireRequest* request, ::dscc::AcquireResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
       virtual void ReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest* request, ::dscc::ReleaseResponse* response, std::function<void(::grpc::Status)>) = 0;
       virtual void ReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest* request, ::dscc::ReleaseResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, std::function<void(::grpc::Status)>) = 0;
+      virtual void RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
     };
     typedef class async_interface experimental_async_interface;
     virtual class async_interface* async() { return nullptr; }
@@ -76,6 +85,8 @@ class LockService final {
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::dscc::AcquireResponse>* PrepareAsyncAcquireGuardRaw(::grpc::ClientContext* context, const ::dscc::AcquireRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::dscc::ReleaseResponse>* AsyncReleaseGuardRaw(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::dscc::ReleaseResponse>* PrepareAsyncReleaseGuardRaw(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>* AsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::dscc::RenewLeaseResponse>* PrepareAsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -101,6 +112,13 @@ class LockService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::ReleaseResponse>> PrepareAsyncReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::ReleaseResponse>>(PrepareAsyncReleaseGuardRaw(context, request, cq));
     }
+    ::grpc::Status RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::dscc::RenewLeaseResponse* response) override;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>> AsyncRenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>>(AsyncRenewLeaseRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>> PrepareAsyncRenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>>(PrepareAsyncRenewLeaseRaw(context, request, cq));
+    }
     class async final :
       public StubInterface::async_interface {
      public:
@@ -110,6 +128,8 @@ class LockService final {
       void AcquireGuard(::grpc::ClientContext* context, const ::dscc::AcquireRequest* request, ::dscc::AcquireResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
       void ReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest* request, ::dscc::ReleaseResponse* response, std::function<void(::grpc::Status)>) override;
       void ReleaseGuard(::grpc::ClientContext* context, const ::dscc::ReleaseRequest* request, ::dscc::ReleaseResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, std::function<void(::grpc::Status)>) override;
+      void RenewLease(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
      private:
       friend class Stub;
       explicit async(Stub* stub): stub_(stub) { }
@@ -127,9 +147,12 @@ class LockService final {
     ::grpc::ClientAsyncResponseReader< ::dscc::AcquireResponse>* PrepareAsyncAcquireGuardRaw(::grpc::ClientContext* context, const ::dscc::AcquireRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::dscc::ReleaseResponse>* AsyncReleaseGuardRaw(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::dscc::ReleaseResponse>* PrepareAsyncReleaseGuardRaw(::grpc::ClientContext* context, const ::dscc::ReleaseRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>* AsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::dscc::RenewLeaseResponse>* PrepareAsyncRenewLeaseRaw(::grpc::ClientContext* context, const ::dscc::RenewLeaseRequest& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_Ping_;
     const ::grpc::internal::RpcMethod rpcmethod_AcquireGuard_;
     const ::grpc::internal::RpcMethod rpcmethod_ReleaseGuard_;
+    const ::grpc::internal::RpcMethod rpcmethod_RenewLease_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -140,6 +163,7 @@ class LockService final {
     virtual ::grpc::Status Ping(::grpc::ServerContext* context, const ::dscc::PingRequest* request, ::dscc::PingResponse* response);
     virtual ::grpc::Status AcquireGuard(::grpc::ServerContext* context, const ::dscc::AcquireRequest* request, ::dscc::AcquireResponse* response);
     virtual ::grpc::Status ReleaseGuard(::grpc::ServerContext* context, const ::dscc::ReleaseRequest* request, ::dscc::ReleaseResponse* response);
+    virtual ::grpc::Status RenewLease(::grpc::ServerContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response);
   };
   template <class BaseClass>
   class WithAsyncMethod_Ping : public BaseClass {
@@ -201,7 +225,27 @@ class LockService final {
       ::grpc::Service::RequestAsyncUnary(2, context, request, response, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_Ping<WithAsyncMethod_AcquireGuard<WithAsyncMethod_ReleaseGuard<Service > > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_RenewLease() {
+      ::grpc::Service::MarkMethodAsync(3);
+    }
+    ~WithAsyncMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestRenewLease(::grpc::ServerContext* context, ::dscc::RenewLeaseRequest* request, ::grpc::ServerAsyncResponseWriter< ::dscc::RenewLeaseResponse>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(3, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_Ping<WithAsyncMethod_AcquireGuard<WithAsyncMethod_ReleaseGuard<WithAsyncMethod_RenewLease<Service > > > > AsyncService;
   template <class BaseClass>
   class WithCallbackMethod_Ping : public BaseClass {
    private:
@@ -283,7 +327,34 @@ class LockService final {
     virtual ::grpc::ServerUnaryReactor* ReleaseGuard(
       ::grpc::CallbackServerContext* /*context*/, const ::dscc::ReleaseRequest* /*request*/, ::dscc::ReleaseResponse* /*response*/)  { return nullptr; }
   };
-  typedef WithCallbackMethod_Ping<WithCallbackMethod_AcquireGuard<WithCallbackMethod_ReleaseGuard<Service > > > CallbackService;
+  template <class BaseClass>
+  class WithCallbackMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_RenewLease() {
+      ::grpc::Service::MarkMethodCallback(3,
+          new ::grpc::internal::CallbackUnaryHandler< ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::dscc::RenewLeaseRequest* request, ::dscc::RenewLeaseResponse* response) { return this->RenewLease(context, request, response); }));}
+    void SetMessageAllocatorFor_RenewLease(
+        ::grpc::MessageAllocator< ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse>* allocator) {
+      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(3);
+      static_cast<::grpc::internal::CallbackUnaryHandler< ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse>*>(handler)
+              ->SetMessageAllocator(allocator);
+    }
+    ~WithCallbackMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* RenewLease(
+      ::grpc::CallbackServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/)  { return nullptr; }
+  };
+  typedef WithCallbackMethod_Ping<WithCallbackMethod_AcquireGuard<WithCallbackMethod_ReleaseGuard<WithCallbackMethod_RenewLease<Service > > > > CallbackService;
   typedef CallbackService ExperimentalCallbackService;
   template <class BaseClass>
   class WithGenericMethod_Ping : public BaseClass {
@@ -337,6 +408,23 @@ class LockService final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_RenewLease() {
+      ::grpc::Service::MarkMethodGeneric(3);
+    }
+    ~WithGenericMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_Ping : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -397,6 +485,26 @@ class LockService final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_RenewLease() {
+      ::grpc::Service::MarkMethodRaw(3);
+    }
+    ~WithRawMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestRenewLease(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(3, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithRawCallbackMethod_Ping : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -463,6 +571,28 @@ class LockService final {
       ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
+  class WithRawCallbackMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_RenewLease() {
+      ::grpc::Service::MarkMethodRawCallback(3,
+          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->RenewLease(context, request, response); }));
+    }
+    ~WithRawCallbackMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* RenewLease(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_Ping : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -543,9 +673,36 @@ class LockService final {
     // replace default version of method with streamed unary
     virtual ::grpc::Status StreamedReleaseGuard(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::dscc::ReleaseRequest,::dscc::ReleaseResponse>* server_unary_streamer) = 0;
   };
-  typedef WithStreamedUnaryMethod_Ping<WithStreamedUnaryMethod_AcquireGuard<WithStreamedUnaryMethod_ReleaseGuard<Service > > > StreamedUnaryService;
+  template <class BaseClass>
+  class WithStreamedUnaryMethod_RenewLease : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithStreamedUnaryMethod_RenewLease() {
+      ::grpc::Service::MarkMethodStreamed(3,
+        new ::grpc::internal::StreamedUnaryHandler<
+          ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerUnaryStreamer<
+                     ::dscc::RenewLeaseRequest, ::dscc::RenewLeaseResponse>* streamer) {
+                       return this->StreamedRenewLease(context,
+                         streamer);
+                  }));
+    }
+    ~WithStreamedUnaryMethod_RenewLease() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status RenewLease(::grpc::ServerContext* /*context*/, const ::dscc::RenewLeaseRequest* /*request*/, ::dscc::RenewLeaseResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with streamed unary
+    virtual ::grpc::Status StreamedRenewLease(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::dscc::RenewLeaseRequest,::dscc::RenewLeaseResponse>* server_unary_streamer) = 0;
+  };
+  typedef WithStreamedUnaryMethod_Ping<WithStreamedUnaryMethod_AcquireGuard<WithStreamedUnaryMethod_ReleaseGuard<WithStreamedUnaryMethod_RenewLease<Service > > > > StreamedUnaryService;
   typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_Ping<WithStreamedUnaryMethod_AcquireGuard<WithStreamedUnaryMethod_ReleaseGuard<Service > > > StreamedService;
+  typedef WithStreamedUnaryMethod_Ping<WithStreamedUnaryMethod_AcquireGuard<WithStreamedUnaryMethod_ReleaseGuard<WithStreamedUnaryMethod_RenewLease<Service > > > > StreamedService;
 };
 
 }  // namespace dscc
@@ -47,13 +47,30 @@ struct PingResponseDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PingResponseDefaultTypeInternal _PingResponse_default_instance_;
+PROTOBUF_CONSTEXPR Embedding::Embedding(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.values_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct EmbeddingDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR EmbeddingDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~EmbeddingDefaultTypeInternal() {}
+  union {
+    Embedding _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 EmbeddingDefaultTypeInternal _Embedding_default_instance_;
 PROTOBUF_CONSTEXPR AcquireRequest::AcquireRequest(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.embedding_)*/{}
+  , /*decltype(_impl_.embeddings_)*/{}
   , /*decltype(_impl_.agent_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.payload_text_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.source_file_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.timestamp_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.omit_blocker_diagnostics_)*/false
+  , /*decltype(_impl_.mode_)*/0
+  , /*decltype(_impl_.lease_ttl_ms_)*/int64_t{0}
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct AcquireRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR AcquireRequestDefaultTypeInternal()
@@ -67,7 +84,16 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORIT
 PROTOBUF_CONSTEXPR AcquireResponse::AcquireResponse(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.message_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.blocking_agent_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.server_received_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.lock_acquired_unix_ms_)*/int64_t{0}
   , /*decltype(_impl_.granted_)*/false
+  , /*decltype(_impl_.blocking_similarity_score_)*/0
+  , /*decltype(_impl_.qdrant_write_complete_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.lock_released_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.lock_wait_ms_)*/int64_t{0}
+  , /*decltype(_impl_.lease_expires_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.queue_position_)*/0
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct AcquireResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR AcquireResponseDefaultTypeInternal()
@@ -104,9 +130,37 @@ struct ReleaseResponseDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ReleaseResponseDefaultTypeInternal _ReleaseResponse_default_instance_;
+PROTOBUF_CONSTEXPR RenewLeaseRequest::RenewLeaseRequest(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.agent_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.lease_ttl_ms_)*/int64_t{0}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct RenewLeaseRequestDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RenewLeaseRequestDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RenewLeaseRequestDefaultTypeInternal() {}
+  union {
+    RenewLeaseRequest _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RenewLeaseRequestDefaultTypeInternal _RenewLeaseRequest_default_instance_;
+PROTOBUF_CONSTEXPR RenewLeaseResponse::RenewLeaseResponse(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.lease_expires_unix_ms_)*/int64_t{0}
+  , /*decltype(_impl_.renewed_)*/false
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct RenewLeaseResponseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RenewLeaseResponseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RenewLeaseResponseDefaultTypeInternal() {}
+  union {
+    RenewLeaseResponse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RenewLeaseResponseDefaultTypeInternal _RenewLeaseResponse_default_instance_;
 }  // namespace dscc
-static ::_pb::Metadata file_level_metadata_dscc_2eproto[6];
-static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_dscc_2eproto = nullptr;
+static ::_pb::Metadata file_level_metadata_dscc_2eproto[9];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_dscc_2eproto[1];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_dscc_2eproto = nullptr;
 
 const uint32_t TableStruct_dscc_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
@@ -125,6 +179,13 @@ const uint32_t TableStruct_dscc_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::dscc::PingResponse, _impl_.message_),
   ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::dscc::Embedding, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::dscc::Embedding, _impl_.values_),
+  ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
@@ -135,6 +196,10 @@ const uint32_t TableStruct_dscc_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.payload_text_),
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.source_file_),
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.timestamp_unix_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.omit_blocker_diagnostics_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.mode_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.embeddings_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireRequest, _impl_.lease_ttl_ms_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -143,6 +208,15 @@ const uint32_t TableStruct_dscc_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.granted_),
   PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.message_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.server_received_unix_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.lock_acquired_unix_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.qdrant_write_complete_unix_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.lock_released_unix_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.lock_wait_ms_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.blocking_similarity_score_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.blocking_agent_id_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.queue_position_),
+  PROTOBUF_FIELD_OFFSET(::dscc::AcquireResponse, _impl_.lease_expires_unix_ms_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::dscc::ReleaseRequest, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -157,46 +231,85 @@ const uint32_t TableStruct_dscc_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::dscc::ReleaseResponse, _impl_.success_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseRequest, _impl_.agent_id_),
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseRequest, _impl_.lease_ttl_ms_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseResponse, _impl_.renewed_),
+  PROTOBUF_FIELD_OFFSET(::dscc::RenewLeaseResponse, _impl_.lease_expires_unix_ms_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::dscc::PingRequest)},
   { 7, -1, -1, sizeof(::dscc::PingResponse)},
-  { 14, -1, -1, sizeof(::dscc::AcquireRequest)},
-  { 25, -1, -1, sizeof(::dscc::AcquireResponse)},
-  { 33, -1, -1, sizeof(::dscc::ReleaseRequest)},
-  { 40, -1, -1, sizeof(::dscc::ReleaseResponse)},
+  { 14, -1, -1, sizeof(::dscc::Embedding)},
+  { 21, -1, -1, sizeof(::dscc::AcquireRequest)},
+  { 36, -1, -1, sizeof(::dscc::AcquireResponse)},
+  { 53, -1, -1, sizeof(::dscc::ReleaseRequest)},
+  { 60, -1, -1, sizeof(::dscc::ReleaseResponse)},
+  { 67, -1, -1, sizeof(::dscc::RenewLeaseRequest)},
+  { 75, -1, -1, sizeof(::dscc::RenewLeaseResponse)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
   &::dscc::_PingRequest_default_instance_._instance,
   &::dscc::_PingResponse_default_instance_._instance,
+  &::dscc::_Embedding_default_instance_._instance,
   &::dscc::_AcquireRequest_default_instance_._instance,
   &::dscc::_AcquireResponse_default_instance_._instance,
   &::dscc::_ReleaseRequest_default_instance_._instance,
   &::dscc::_ReleaseResponse_default_instance_._instance,
+  &::dscc::_RenewLeaseRequest_default_instance_._instance,
+  &::dscc::_RenewLeaseResponse_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_dscc_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\ndscc.proto\022\004dscc\" \n\013PingRequest\022\021\n\tfro"
   "m_node\030\001 \001(\t\"\037\n\014PingResponse\022\017\n\007message\030"
-  "\001 \001(\t\"{\n\016AcquireRequest\022\020\n\010agent_id\030\001 \001("
-  "\t\022\021\n\tembedding\030\002 \003(\002\022\024\n\014payload_text\030\003 \001"
-  "(\t\022\023\n\013source_file\030\004 \001(\t\022\031\n\021timestamp_uni"
-  "x_ms\030\005 \001(\003\"3\n\017AcquireResponse\022\017\n\007granted"
-  "\030\001 \001(\010\022\017\n\007message\030\002 \001(\t\"\"\n\016ReleaseReques"
-  "t\022\020\n\010agent_id\030\001 \001(\t\"\"\n\017ReleaseResponse\022\017"
-  "\n\007success\030\001 \001(\0102\266\001\n\013LockService\022-\n\004Ping\022"
-  "\021.dscc.PingRequest\032\022.dscc.PingResponse\022;"
-  "\n\014AcquireGuard\022\024.dscc.AcquireRequest\032\025.d"
-  "scc.AcquireResponse\022;\n\014ReleaseGuard\022\024.ds"
-  "cc.ReleaseRequest\032\025.dscc.ReleaseResponse"
-  "b\006proto3"
+  "\001 \001(\t\"\033\n\tEmbedding\022\016\n\006values\030\001 \003(\002\"\366\001\n\016A"
+  "cquireRequest\022\020\n\010agent_id\030\001 \001(\t\022\021\n\tembed"
+  "ding\030\002 \003(\002\022\024\n\014payload_text\030\003 \001(\t\022\023\n\013sour"
+  "ce_file\030\004 \001(\t\022\031\n\021timestamp_unix_ms\030\005 \001(\003"
+  "\022 \n\030omit_blocker_diagnostics\030\006 \001(\010\022\034\n\004mo"
+  "de\030\007 \001(\0162\016.dscc.LockMode\022#\n\nembeddings\030\010"
+  " \003(\0132\017.dscc.Embedding\022\024\n\014lease_ttl_ms\030\t "
+  "\001(\003\"\304\002\n\017AcquireResponse\022\017\n\007granted\030\001 \001(\010"
+  "\022\017\n\007message\030\002 \001(\t\022\037\n\027server_received_uni"
+  "x_ms\030\003 \001(\003\022\035\n\025lock_acquired_unix_ms\030\004 \001("
+  "\003\022%\n\035qdrant_write_complete_unix_ms\030\005 \001(\003"
+  "\022\035\n\025lock_released_unix_ms\030\006 \001(\003\022\024\n\014lock_"
+  "wait_ms\030\007 \001(\003\022!\n\031blocking_similarity_sco"
+  "re\030\010 \001(\002\022\031\n\021blocking_agent_id\030\t \001(\t\022\026\n\016q"
+  "ueue_position\030\n \001(\005\022\035\n\025lease_expires_uni"
+  "x_ms\030\013 \001(\003\"\"\n\016ReleaseRequest\022\020\n\010agent_id"
+  "\030\001 \001(\t\"\"\n\017ReleaseResponse\022\017\n\007success\030\001 \001"
+  "(\010\";\n\021RenewLeaseRequest\022\020\n\010agent_id\030\001 \001("
+  "\t\022\024\n\014lease_ttl_ms\030\002 \001(\003\"D\n\022RenewLeaseRes"
+  "ponse\022\017\n\007renewed\030\001 \001(\010\022\035\n\025lease_expires_"
+  "unix_ms\030\002 \001(\003*9\n\010LockMode\022\027\n\023LOCK_MODE_E"
+  "XCLUSIVE\020\000\022\024\n\020LOCK_MODE_SHARED\020\0012\367\001\n\013Loc"
+  "kService\022-\n\004Ping\022\021.dscc.PingRequest\032\022.ds"
+  "cc.PingResponse\022;\n\014AcquireGuard\022\024.dscc.A"
+  "cquireRequest\032\025.dscc.AcquireResponse\022;\n\014"
+  "ReleaseGuard\022\024.dscc.ReleaseRequest\032\025.dsc"
+  "c.ReleaseResponse\022\?\n\nRenewLease\022\027.dscc.R"
+  "enewLeaseRequest\032\030.dscc.RenewLeaseRespon"
+  "seb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_dscc_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_dscc_2eproto = {
-    false, false, 528, descriptor_table_protodef_dscc_2eproto,
+    false, false, 1210, descriptor_table_protodef_dscc_2eproto,
     "dscc.proto",
-    &descriptor_table_dscc_2eproto_once, nullptr, 0, 6,
+    &descriptor_table_dscc_2eproto_once, nullptr, 0, 9,
     schemas, file_default_instances, TableStruct_dscc_2eproto::offsets,
     file_level_metadata_dscc_2eproto, file_level_enum_descriptors_dscc_2eproto,
     file_level_service_descriptors_dscc_2eproto,
@@ -208,6 +321,20 @@ PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_dscc_2ep
 // Force running AddDescriptors() at dynamic initialization time.
 PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_dscc_2eproto(&descriptor_table_dscc_2eproto);
 namespace dscc {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* LockMode_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_dscc_2eproto);
+  return file_level_enum_descriptors_dscc_2eproto[0];
+}
+bool LockMode_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+      return true;
+    default:
+      return false;
+  }
+}
+
 
 // ===================================================================
 
@@ -617,6 +744,190 @@ void PingResponse::InternalSwap(PingResponse* other) {
 
 // ===================================================================
 
+class Embedding::_Internal {
+ public:
+};
+
+Embedding::Embedding(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:dscc.Embedding)
+}
+Embedding::Embedding(const Embedding& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Embedding* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.values_){from._impl_.values_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:dscc.Embedding)
+}
+
+inline void Embedding::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.values_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+Embedding::~Embedding() {
+  // @@protoc_insertion_point(destructor:dscc.Embedding)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Embedding::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.values_.~RepeatedField();
+}
+
+void Embedding::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Embedding::Clear() {
+// @@protoc_insertion_point(message_clear_start:dscc.Embedding)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.values_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Embedding::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated float values = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedFloatParser(_internal_mutable_values(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 13) {
+          _internal_add_values(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr));
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Embedding::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:dscc.Embedding)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated float values = 1;
+  if (this->_internal_values_size() > 0) {
+    target = stream->WriteFixedPacked(1, _internal_values(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:dscc.Embedding)
+  return target;
+}
+
+size_t Embedding::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:dscc.Embedding)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated float values = 1;
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_values_size());
+    size_t data_size = 4UL * count;
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    total_size += data_size;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Embedding::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Embedding::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Embedding::GetClassData() const { return &_class_data_; }
+
+
+void Embedding::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Embedding*>(&to_msg);
+  auto& from = static_cast<const Embedding&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:dscc.Embedding)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.values_.MergeFrom(from._impl_.values_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Embedding::CopyFrom(const Embedding& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:dscc.Embedding)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Embedding::IsInitialized() const {
+  return true;
+}
+
+void Embedding::InternalSwap(Embedding* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.values_.InternalSwap(&other->_impl_.values_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Embedding::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
+      file_level_metadata_dscc_2eproto[2]);
+}
+
+// ===================================================================
+
 class AcquireRequest::_Internal {
  public:
 };
@@ -632,10 +943,14 @@ AcquireRequest::AcquireRequest(const AcquireRequest& from)
   AcquireRequest* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.embedding_){from._impl_.embedding_}
+    , decltype(_impl_.embeddings_){from._impl_.embeddings_}
     , decltype(_impl_.agent_id_){}
     , decltype(_impl_.payload_text_){}
     , decltype(_impl_.source_file_){}
     , decltype(_impl_.timestamp_unix_ms_){}
+    , decltype(_impl_.omit_blocker_diagnostics_){}
+    , decltype(_impl_.mode_){}
+    , decltype(_impl_.lease_ttl_ms_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -663,7 +978,9 @@ AcquireRequest::AcquireRequest(const AcquireRequest& from)
     _this->_impl_.source_file_.Set(from._internal_source_file(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.timestamp_unix_ms_ = from._impl_.timestamp_unix_ms_;
+  ::memcpy(&_impl_.timestamp_unix_ms_, &from._impl_.timestamp_unix_ms_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.lease_ttl_ms_) -
+    reinterpret_cast<char*>(&_impl_.timestamp_unix_ms_)) + sizeof(_impl_.lease_ttl_ms_));
   // @@protoc_insertion_point(copy_constructor:dscc.AcquireRequest)
 }
 
@@ -673,10 +990,14 @@ inline void AcquireRequest::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.embedding_){arena}
+    , decltype(_impl_.embeddings_){arena}
     , decltype(_impl_.agent_id_){}
     , decltype(_impl_.payload_text_){}
     , decltype(_impl_.source_file_){}
     , decltype(_impl_.timestamp_unix_ms_){int64_t{0}}
+    , decltype(_impl_.omit_blocker_diagnostics_){false}
+    , decltype(_impl_.mode_){0}
+    , decltype(_impl_.lease_ttl_ms_){int64_t{0}}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.agent_id_.InitDefault();
@@ -705,6 +1026,7 @@ AcquireRequest::~AcquireRequest() {
 inline void AcquireRequest::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
   _impl_.embedding_.~RepeatedField();
+  _impl_.embeddings_.~RepeatedPtrField();
   _impl_.agent_id_.Destroy();
   _impl_.payload_text_.Destroy();
   _impl_.source_file_.Destroy();
@@ -721,10 +1043,13 @@ void AcquireRequest::Clear() {
   (void) cached_has_bits;
 
   _impl_.embedding_.Clear();
+  _impl_.embeddings_.Clear();
   _impl_.agent_id_.ClearToEmpty();
   _impl_.payload_text_.ClearToEmpty();
   _impl_.source_file_.ClearToEmpty();
-  _impl_.timestamp_unix_ms_ = int64_t{0};
+  ::memset(&_impl_.timestamp_unix_ms_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.lease_ttl_ms_) -
+      reinterpret_cast<char*>(&_impl_.timestamp_unix_ms_)) + sizeof(_impl_.lease_ttl_ms_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -783,6 +1108,44 @@ const char* AcquireRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext
         } else
           goto handle_unusual;
         continue;
+      // bool omit_blocker_diagnostics = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.omit_blocker_diagnostics_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .dscc.LockMode mode = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_mode(static_cast<::dscc::LockMode>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .dscc.Embedding embeddings = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_embeddings(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<66>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lease_ttl_ms = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          _impl_.lease_ttl_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -853,6 +1216,33 @@ uint8_t* AcquireRequest::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteInt64ToArray(5, this->_internal_timestamp_unix_ms(), target);
   }
 
+  // bool omit_blocker_diagnostics = 6;
+  if (this->_internal_omit_blocker_diagnostics() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(6, this->_internal_omit_blocker_diagnostics(), target);
+  }
+
+  // .dscc.LockMode mode = 7;
+  if (this->_internal_mode() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      7, this->_internal_mode(), target);
+  }
+
+  // repeated .dscc.Embedding embeddings = 8;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_embeddings_size()); i < n; i++) {
+    const auto& repfield = this->_internal_embeddings(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(8, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // int64 lease_ttl_ms = 9;
+  if (this->_internal_lease_ttl_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(9, this->_internal_lease_ttl_ms(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -880,6 +1270,13 @@ size_t AcquireRequest::ByteSizeLong() const {
     total_size += data_size;
   }
 
+  // repeated .dscc.Embedding embeddings = 8;
+  total_size += 1UL * this->_internal_embeddings_size();
+  for (const auto& msg : this->_impl_.embeddings_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
   // string agent_id = 1;
   if (!this->_internal_agent_id().empty()) {
     total_size += 1 +
@@ -906,6 +1303,22 @@ size_t AcquireRequest::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_timestamp_unix_ms());
   }
 
+  // bool omit_blocker_diagnostics = 6;
+  if (this->_internal_omit_blocker_diagnostics() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // .dscc.LockMode mode = 7;
+  if (this->_internal_mode() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_mode());
+  }
+
+  // int64 lease_ttl_ms = 9;
+  if (this->_internal_lease_ttl_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lease_ttl_ms());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -925,6 +1338,7 @@ void AcquireRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const :
   (void) cached_has_bits;
 
   _this->_impl_.embedding_.MergeFrom(from._impl_.embedding_);
+  _this->_impl_.embeddings_.MergeFrom(from._impl_.embeddings_);
   if (!from._internal_agent_id().empty()) {
     _this->_internal_set_agent_id(from._internal_agent_id());
   }
@@ -937,6 +1351,15 @@ void AcquireRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const :
   if (from._internal_timestamp_unix_ms() != 0) {
     _this->_internal_set_timestamp_unix_ms(from._internal_timestamp_unix_ms());
   }
+  if (from._internal_omit_blocker_diagnostics() != 0) {
+    _this->_internal_set_omit_blocker_diagnostics(from._internal_omit_blocker_diagnostics());
+  }
+  if (from._internal_mode() != 0) {
+    _this->_internal_set_mode(from._internal_mode());
+  }
+  if (from._internal_lease_ttl_ms() != 0) {
+    _this->_internal_set_lease_ttl_ms(from._internal_lease_ttl_ms());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -957,6 +1380,7 @@ void AcquireRequest::InternalSwap(AcquireRequest* other) {
   auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   _impl_.embedding_.InternalSwap(&other->_impl_.embedding_);
+  _impl_.embeddings_.InternalSwap(&other->_impl_.embeddings_);
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
       &_impl_.agent_id_, lhs_arena,
       &other->_impl_.agent_id_, rhs_arena
@@ -969,13 +1393,18 @@ void AcquireRequest::InternalSwap(AcquireRequest* other) {
       &_impl_.source_file_, lhs_arena,
       &other->_impl_.source_file_, rhs_arena
   );
-  swap(_impl_.timestamp_unix_ms_, other->_impl_.timestamp_unix_ms_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(AcquireRequest, _impl_.lease_ttl_ms_)
+      + sizeof(AcquireRequest::_impl_.lease_ttl_ms_)
+      - PROTOBUF_FIELD_OFFSET(AcquireRequest, _impl_.timestamp_unix_ms_)>(
+          reinterpret_cast<char*>(&_impl_.timestamp_unix_ms_),
+          reinterpret_cast<char*>(&other->_impl_.timestamp_unix_ms_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata AcquireRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
-      file_level_metadata_dscc_2eproto[2]);
+      file_level_metadata_dscc_2eproto[3]);
 }
 
 // ===================================================================
@@ -995,7 +1424,16 @@ AcquireResponse::AcquireResponse(const AcquireResponse& from)
   AcquireResponse* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.message_){}
+    , decltype(_impl_.blocking_agent_id_){}
+    , decltype(_impl_.server_received_unix_ms_){}
+    , decltype(_impl_.lock_acquired_unix_ms_){}
     , decltype(_impl_.granted_){}
+    , decltype(_impl_.blocking_similarity_score_){}
+    , decltype(_impl_.qdrant_write_complete_unix_ms_){}
+    , decltype(_impl_.lock_released_unix_ms_){}
+    , decltype(_impl_.lock_wait_ms_){}
+    , decltype(_impl_.lease_expires_unix_ms_){}
+    , decltype(_impl_.queue_position_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -1007,7 +1445,17 @@ AcquireResponse::AcquireResponse(const AcquireResponse& from)
     _this->_impl_.message_.Set(from._internal_message(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.granted_ = from._impl_.granted_;
+  _impl_.blocking_agent_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.blocking_agent_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_blocking_agent_id().empty()) {
+    _this->_impl_.blocking_agent_id_.Set(from._internal_blocking_agent_id(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.server_received_unix_ms_, &from._impl_.server_received_unix_ms_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.queue_position_) -
+    reinterpret_cast<char*>(&_impl_.server_received_unix_ms_)) + sizeof(_impl_.queue_position_));
   // @@protoc_insertion_point(copy_constructor:dscc.AcquireResponse)
 }
 
@@ -1017,13 +1465,26 @@ inline void AcquireResponse::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.message_){}
+    , decltype(_impl_.blocking_agent_id_){}
+    , decltype(_impl_.server_received_unix_ms_){int64_t{0}}
+    , decltype(_impl_.lock_acquired_unix_ms_){int64_t{0}}
     , decltype(_impl_.granted_){false}
+    , decltype(_impl_.blocking_similarity_score_){0}
+    , decltype(_impl_.qdrant_write_complete_unix_ms_){int64_t{0}}
+    , decltype(_impl_.lock_released_unix_ms_){int64_t{0}}
+    , decltype(_impl_.lock_wait_ms_){int64_t{0}}
+    , decltype(_impl_.lease_expires_unix_ms_){int64_t{0}}
+    , decltype(_impl_.queue_position_){0}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.message_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
     _impl_.message_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.blocking_agent_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.blocking_agent_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 AcquireResponse::~AcquireResponse() {
@@ -1038,6 +1499,7 @@ AcquireResponse::~AcquireResponse() {
 inline void AcquireResponse::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
   _impl_.message_.Destroy();
+  _impl_.blocking_agent_id_.Destroy();
 }
 
 void AcquireResponse::SetCachedSize(int size) const {
@@ -1051,7 +1513,10 @@ void AcquireResponse::Clear() {
   (void) cached_has_bits;
 
   _impl_.message_.ClearToEmpty();
-  _impl_.granted_ = false;
+  _impl_.blocking_agent_id_.ClearToEmpty();
+  ::memset(&_impl_.server_received_unix_ms_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.queue_position_) -
+      reinterpret_cast<char*>(&_impl_.server_received_unix_ms_)) + sizeof(_impl_.queue_position_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -1079,40 +1544,114 @@ const char* AcquireResponse::_InternalParse(const char* ptr, ::_pbi::ParseContex
         } else
           goto handle_unusual;
         continue;
-      default:
-        goto handle_unusual;
-    }  // switch
-  handle_unusual:
-    if ((tag == 0) || ((tag & 7) == 4)) {
-      CHK_(ptr);
-      ctx->SetLastTag(tag);
-      goto message_done;
-    }
-    ptr = UnknownFieldParse(
-        tag,
-        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-        ptr, ctx);
-    CHK_(ptr != nullptr);
-  }  // while
-message_done:
-  return ptr;
-failure:
-  ptr = nullptr;
-  goto message_done;
-#undef CHK_
-}
-
-uint8_t* AcquireResponse::_InternalSerialize(
-    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:dscc.AcquireResponse)
-  uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
-
-  // bool granted = 1;
-  if (this->_internal_granted() != 0) {
-    target = stream->EnsureSpace(target);
-    target = ::_pbi::WireFormatLite::WriteBoolToArray(1, this->_internal_granted(), target);
-  }
+      // int64 server_received_unix_ms = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.server_received_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lock_acquired_unix_ms = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.lock_acquired_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 qdrant_write_complete_unix_ms = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.qdrant_write_complete_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lock_released_unix_ms = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.lock_released_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lock_wait_ms = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.lock_wait_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // float blocking_similarity_score = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 69)) {
+          _impl_.blocking_similarity_score_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // string blocking_agent_id = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          auto str = _internal_mutable_blocking_agent_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "dscc.AcquireResponse.blocking_agent_id"));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 queue_position = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          _impl_.queue_position_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lease_expires_unix_ms = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 88)) {
+          _impl_.lease_expires_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* AcquireResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:dscc.AcquireResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // bool granted = 1;
+  if (this->_internal_granted() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(1, this->_internal_granted(), target);
+  }
 
   // string message = 2;
   if (!this->_internal_message().empty()) {
@@ -1124,6 +1663,68 @@ uint8_t* AcquireResponse::_InternalSerialize(
         2, this->_internal_message(), target);
   }
 
+  // int64 server_received_unix_ms = 3;
+  if (this->_internal_server_received_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(3, this->_internal_server_received_unix_ms(), target);
+  }
+
+  // int64 lock_acquired_unix_ms = 4;
+  if (this->_internal_lock_acquired_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(4, this->_internal_lock_acquired_unix_ms(), target);
+  }
+
+  // int64 qdrant_write_complete_unix_ms = 5;
+  if (this->_internal_qdrant_write_complete_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(5, this->_internal_qdrant_write_complete_unix_ms(), target);
+  }
+
+  // int64 lock_released_unix_ms = 6;
+  if (this->_internal_lock_released_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(6, this->_internal_lock_released_unix_ms(), target);
+  }
+
+  // int64 lock_wait_ms = 7;
+  if (this->_internal_lock_wait_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(7, this->_internal_lock_wait_ms(), target);
+  }
+
+  // float blocking_similarity_score = 8;
+  static_assert(sizeof(uint32_t) == sizeof(float), "Code assumes uint32_t and float are the same size.");
+  float tmp_blocking_similarity_score = this->_internal_blocking_similarity_score();
+  uint32_t raw_blocking_similarity_score;
+  memcpy(&raw_blocking_similarity_score, &tmp_blocking_similarity_score, sizeof(tmp_blocking_similarity_score));
+  if (raw_blocking_similarity_score != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(8, this->_internal_blocking_similarity_score(), target);
+  }
+
+  // string blocking_agent_id = 9;
+  if (!this->_internal_blocking_agent_id().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_blocking_agent_id().data(), static_cast<int>(this->_internal_blocking_agent_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "dscc.AcquireResponse.blocking_agent_id");
+    target = stream->WriteStringMaybeAliased(
+        9, this->_internal_blocking_agent_id(), target);
+  }
+
+  // int32 queue_position = 10;
+  if (this->_internal_queue_position() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(10, this->_internal_queue_position(), target);
+  }
+
+  // int64 lease_expires_unix_ms = 11;
+  if (this->_internal_lease_expires_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(11, this->_internal_lease_expires_unix_ms(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1147,11 +1748,62 @@ size_t AcquireResponse::ByteSizeLong() const {
         this->_internal_message());
   }
 
+  // string blocking_agent_id = 9;
+  if (!this->_internal_blocking_agent_id().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_blocking_agent_id());
+  }
+
+  // int64 server_received_unix_ms = 3;
+  if (this->_internal_server_received_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_server_received_unix_ms());
+  }
+
+  // int64 lock_acquired_unix_ms = 4;
+  if (this->_internal_lock_acquired_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lock_acquired_unix_ms());
+  }
+
   // bool granted = 1;
   if (this->_internal_granted() != 0) {
     total_size += 1 + 1;
   }
 
+  // float blocking_similarity_score = 8;
+  static_assert(sizeof(uint32_t) == sizeof(float), "Code assumes uint32_t and float are the same size.");
+  float tmp_blocking_similarity_score = this->_internal_blocking_similarity_score();
+  uint32_t raw_blocking_similarity_score;
+  memcpy(&raw_blocking_similarity_score, &tmp_blocking_similarity_score, sizeof(tmp_blocking_similarity_score));
+  if (raw_blocking_similarity_score != 0) {
+    total_size += 1 + 4;
+  }
+
+  // int64 qdrant_write_complete_unix_ms = 5;
+  if (this->_internal_qdrant_write_complete_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_qdrant_write_complete_unix_ms());
+  }
+
+  // int64 lock_released_unix_ms = 6;
+  if (this->_internal_lock_released_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lock_released_unix_ms());
+  }
+
+  // int64 lock_wait_ms = 7;
+  if (this->_internal_lock_wait_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lock_wait_ms());
+  }
+
+  // int64 lease_expires_unix_ms = 11;
+  if (this->_internal_lease_expires_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lease_expires_unix_ms());
+  }
+
+  // int32 queue_position = 10;
+  if (this->_internal_queue_position() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_queue_position());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -1173,9 +1825,40 @@ void AcquireResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const
   if (!from._internal_message().empty()) {
     _this->_internal_set_message(from._internal_message());
   }
+  if (!from._internal_blocking_agent_id().empty()) {
+    _this->_internal_set_blocking_agent_id(from._internal_blocking_agent_id());
+  }
+  if (from._internal_server_received_unix_ms() != 0) {
+    _this->_internal_set_server_received_unix_ms(from._internal_server_received_unix_ms());
+  }
+  if (from._internal_lock_acquired_unix_ms() != 0) {
+    _this->_internal_set_lock_acquired_unix_ms(from._internal_lock_acquired_unix_ms());
+  }
   if (from._internal_granted() != 0) {
     _this->_internal_set_granted(from._internal_granted());
   }
+  static_assert(sizeof(uint32_t) == sizeof(float), "Code assumes uint32_t and float are the same size.");
+  float tmp_blocking_similarity_score = from._internal_blocking_similarity_score();
+  uint32_t raw_blocking_similarity_score;
+  memcpy(&raw_blocking_similarity_score, &tmp_blocking_similarity_score, sizeof(tmp_blocking_similarity_score));
+  if (raw_blocking_similarity_score != 0) {
+    _this->_internal_set_blocking_similarity_score(from._internal_blocking_similarity_score());
+  }
+  if (from._internal_qdrant_write_complete_unix_ms() != 0) {
+    _this->_internal_set_qdrant_write_complete_unix_ms(from._internal_qdrant_write_complete_unix_ms());
+  }
+  if (from._internal_lock_released_unix_ms() != 0) {
+    _this->_internal_set_lock_released_unix_ms(from._internal_lock_released_unix_ms());
+  }
+  if (from._internal_lock_wait_ms() != 0) {
+    _this->_internal_set_lock_wait_ms(from._internal_lock_wait_ms());
+  }
+  if (from._internal_lease_expires_unix_ms() != 0) {
+    _this->_internal_set_lease_expires_unix_ms(from._internal_lease_expires_unix_ms());
+  }
+  if (from._internal_queue_position() != 0) {
+    _this->_internal_set_queue_position(from._internal_queue_position());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -1199,13 +1882,22 @@ void AcquireResponse::InternalSwap(AcquireResponse* other) {
       &_impl_.message_, lhs_arena,
       &other->_impl_.message_, rhs_arena
   );
-  swap(_impl_.granted_, other->_impl_.granted_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.blocking_agent_id_, lhs_arena,
+      &other->_impl_.blocking_agent_id_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(AcquireResponse, _impl_.queue_position_)
+      + sizeof(AcquireResponse::_impl_.queue_position_)
+      - PROTOBUF_FIELD_OFFSET(AcquireResponse, _impl_.server_received_unix_ms_)>(
+          reinterpret_cast<char*>(&_impl_.server_received_unix_ms_),
+          reinterpret_cast<char*>(&other->_impl_.server_received_unix_ms_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata AcquireResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
-      file_level_metadata_dscc_2eproto[3]);
+      file_level_metadata_dscc_2eproto[4]);
 }
 
 // ===================================================================
@@ -1408,7 +2100,7 @@ void ReleaseRequest::InternalSwap(ReleaseRequest* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata ReleaseRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
-      file_level_metadata_dscc_2eproto[4]);
+      file_level_metadata_dscc_2eproto[5]);
 }
 
 // ===================================================================
@@ -1586,7 +2278,448 @@ void ReleaseResponse::InternalSwap(ReleaseResponse* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata ReleaseResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
-      file_level_metadata_dscc_2eproto[5]);
+      file_level_metadata_dscc_2eproto[6]);
+}
+
+// ===================================================================
+
+class RenewLeaseRequest::_Internal {
+ public:
+};
+
+RenewLeaseRequest::RenewLeaseRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:dscc.RenewLeaseRequest)
+}
+RenewLeaseRequest::RenewLeaseRequest(const RenewLeaseRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  RenewLeaseRequest* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.agent_id_){}
+    , decltype(_impl_.lease_ttl_ms_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.agent_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.agent_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_agent_id().empty()) {
+    _this->_impl_.agent_id_.Set(from._internal_agent_id(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.lease_ttl_ms_ = from._impl_.lease_ttl_ms_;
+  // @@protoc_insertion_point(copy_constructor:dscc.RenewLeaseRequest)
+}
+
+inline void RenewLeaseRequest::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.agent_id_){}
+    , decltype(_impl_.lease_ttl_ms_){int64_t{0}}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.agent_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.agent_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+RenewLeaseRequest::~RenewLeaseRequest() {
+  // @@protoc_insertion_point(destructor:dscc.RenewLeaseRequest)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void RenewLeaseRequest::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.agent_id_.Destroy();
+}
+
+void RenewLeaseRequest::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void RenewLeaseRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:dscc.RenewLeaseRequest)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.agent_id_.ClearToEmpty();
+  _impl_.lease_ttl_ms_ = int64_t{0};
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* RenewLeaseRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // string agent_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_agent_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "dscc.RenewLeaseRequest.agent_id"));
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lease_ttl_ms = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.lease_ttl_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* RenewLeaseRequest::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:dscc.RenewLeaseRequest)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string agent_id = 1;
+  if (!this->_internal_agent_id().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_agent_id().data(), static_cast<int>(this->_internal_agent_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "dscc.RenewLeaseRequest.agent_id");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_agent_id(), target);
+  }
+
+  // int64 lease_ttl_ms = 2;
+  if (this->_internal_lease_ttl_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(2, this->_internal_lease_ttl_ms(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:dscc.RenewLeaseRequest)
+  return target;
+}
+
+size_t RenewLeaseRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:dscc.RenewLeaseRequest)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string agent_id = 1;
+  if (!this->_internal_agent_id().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_agent_id());
+  }
+
+  // int64 lease_ttl_ms = 2;
+  if (this->_internal_lease_ttl_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lease_ttl_ms());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData RenewLeaseRequest::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    RenewLeaseRequest::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*RenewLeaseRequest::GetClassData() const { return &_class_data_; }
+
+
+void RenewLeaseRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<RenewLeaseRequest*>(&to_msg);
+  auto& from = static_cast<const RenewLeaseRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:dscc.RenewLeaseRequest)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_agent_id().empty()) {
+    _this->_internal_set_agent_id(from._internal_agent_id());
+  }
+  if (from._internal_lease_ttl_ms() != 0) {
+    _this->_internal_set_lease_ttl_ms(from._internal_lease_ttl_ms());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void RenewLeaseRequest::CopyFrom(const RenewLeaseRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:dscc.RenewLeaseRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RenewLeaseRequest::IsInitialized() const {
+  return true;
+}
+
+void RenewLeaseRequest::InternalSwap(RenewLeaseRequest* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.agent_id_, lhs_arena,
+      &other->_impl_.agent_id_, rhs_arena
+  );
+  swap(_impl_.lease_ttl_ms_, other->_impl_.lease_ttl_ms_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RenewLeaseRequest::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
+      file_level_metadata_dscc_2eproto[7]);
+}
+
+// ===================================================================
+
+class RenewLeaseResponse::_Internal {
+ public:
+};
+
+RenewLeaseResponse::RenewLeaseResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:dscc.RenewLeaseResponse)
+}
+RenewLeaseResponse::RenewLeaseResponse(const RenewLeaseResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  RenewLeaseResponse* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.lease_expires_unix_ms_){}
+    , decltype(_impl_.renewed_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.lease_expires_unix_ms_, &from._impl_.lease_expires_unix_ms_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.renewed_) -
+    reinterpret_cast<char*>(&_impl_.lease_expires_unix_ms_)) + sizeof(_impl_.renewed_));
+  // @@protoc_insertion_point(copy_constructor:dscc.RenewLeaseResponse)
+}
+
+inline void RenewLeaseResponse::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.lease_expires_unix_ms_){int64_t{0}}
+    , decltype(_impl_.renewed_){false}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+RenewLeaseResponse::~RenewLeaseResponse() {
+  // @@protoc_insertion_point(destructor:dscc.RenewLeaseResponse)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void RenewLeaseResponse::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void RenewLeaseResponse::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void RenewLeaseResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:dscc.RenewLeaseResponse)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&_impl_.lease_expires_unix_ms_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.renewed_) -
+      reinterpret_cast<char*>(&_impl_.lease_expires_unix_ms_)) + sizeof(_impl_.renewed_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* RenewLeaseResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // bool renewed = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.renewed_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int64 lease_expires_unix_ms = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.lease_expires_unix_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* RenewLeaseResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:dscc.RenewLeaseResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // bool renewed = 1;
+  if (this->_internal_renewed() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(1, this->_internal_renewed(), target);
+  }
+
+  // int64 lease_expires_unix_ms = 2;
+  if (this->_internal_lease_expires_unix_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(2, this->_internal_lease_expires_unix_ms(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:dscc.RenewLeaseResponse)
+  return target;
+}
+
+size_t RenewLeaseResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:dscc.RenewLeaseResponse)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // int64 lease_expires_unix_ms = 2;
+  if (this->_internal_lease_expires_unix_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_lease_expires_unix_ms());
+  }
+
+  // bool renewed = 1;
+  if (this->_internal_renewed() != 0) {
+    total_size += 1 + 1;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData RenewLeaseResponse::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    RenewLeaseResponse::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*RenewLeaseResponse::GetClassData() const { return &_class_data_; }
+
+
+void RenewLeaseResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<RenewLeaseResponse*>(&to_msg);
+  auto& from = static_cast<const RenewLeaseResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:dscc.RenewLeaseResponse)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_lease_expires_unix_ms() != 0) {
+    _this->_internal_set_lease_expires_unix_ms(from._internal_lease_expires_unix_ms());
+  }
+  if (from._internal_renewed() != 0) {
+    _this->_internal_set_renewed(from._internal_renewed());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void RenewLeaseResponse::CopyFrom(const RenewLeaseResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:dscc.RenewLeaseResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RenewLeaseResponse::IsInitialized() const {
+  return true;
+}
+
+void RenewLeaseResponse::InternalSwap(RenewLeaseResponse* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(RenewLeaseResponse, _impl_.renewed_)
+      + sizeof(RenewLeaseResponse::_impl_.renewed_)
+      - PROTOBUF_FIELD_OFFSET(RenewLeaseResponse, _impl_.lease_expires_unix_ms_)>(
+          reinterpret_cast<char*>(&_impl_.lease_expires_unix_ms_),
+          reinterpret_cast<char*>(&other->_impl_.lease_expires_unix_ms_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RenewLeaseResponse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_dscc_2eproto_getter, &descriptor_table_dscc_2eproto_once,
+      file_level_metadata_dscc_2eproto[8]);
 }
 
 // @@protoc_insertion_point(namespace_scope)
@@ -1600,6 +2733,10 @@ template<> PROTOBUF_NOINLINE ::dscc::PingResponse*
 Arena::CreateMaybeMessage< ::dscc::PingResponse >(Arena* arena) {
   return Arena::CreateMessageInternal< ::dscc::PingResponse >(arena);
 }
+template<> PROTOBUF_NOINLINE ::dscc::Embedding*
+Arena::CreateMaybeMessage< ::dscc::Embedding >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::dscc::Embedding >(arena);
+}
 template<> PROTOBUF_NOINLINE ::dscc::AcquireRequest*
 Arena::CreateMaybeMessage< ::dscc::AcquireRequest >(Arena* arena) {
   return Arena::CreateMessageInternal< ::dscc::AcquireRequest >(arena);
@@ -1616,6 +2753,14 @@ template<> PROTOBUF_NOINLINE ::dscc::ReleaseResponse*
 Arena::CreateMaybeMessage< ::dscc::ReleaseResponse >(Arena* arena) {
   return Arena::CreateMessageInternal< ::dscc::ReleaseResponse >(arena);
 }
+template<> PROTOBUF_NOINLINE ::dscc::RenewLeaseRequest*
+Arena::CreateMaybeMessage< ::dscc::RenewLeaseRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::dscc::RenewLeaseRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::dscc::RenewLeaseResponse*
+Arena::CreateMaybeMessage< ::dscc::RenewLeaseResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::dscc::RenewLeaseResponse >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
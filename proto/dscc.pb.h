@@ -29,6 +29,7 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/repeated_field.h>  // IWYU pragma: export
 #include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
 #include <google/protobuf/unknown_field_set.h>
 // @@protoc_insertion_point(includes)
 #include <google/protobuf/port_def.inc>
@@ -51,6 +52,9 @@ extern AcquireRequestDefaultTypeInternal _AcquireRequest_default_instance_;
 class AcquireResponse;
 struct AcquireResponseDefaultTypeInternal;
 extern AcquireResponseDefaultTypeInternal _AcquireResponse_default_instance_;
+class Embedding;
+struct EmbeddingDefaultTypeInternal;
+extern EmbeddingDefaultTypeInternal _Embedding_default_instance_;
 class PingRequest;
 struct PingRequestDefaultTypeInternal;
 extern PingRequestDefaultTypeInternal _PingRequest_default_instance_;
@@ -63,17 +67,51 @@ extern ReleaseRequestDefaultTypeInternal _ReleaseRequest_default_instance_;
 class ReleaseResponse;
 struct ReleaseResponseDefaultTypeInternal;
 extern ReleaseResponseDefaultTypeInternal _ReleaseResponse_default_instance_;
+class RenewLeaseRequest;
+struct RenewLeaseRequestDefaultTypeInternal;
+extern RenewLeaseRequestDefaultTypeInternal _RenewLeaseRequest_default_instance_;
+class RenewLeaseResponse;
+struct RenewLeaseResponseDefaultTypeInternal;
+extern RenewLeaseResponseDefaultTypeInternal _RenewLeaseResponse_default_instance_;
 }  // namespace dscc
 PROTOBUF_NAMESPACE_OPEN
 template<> ::dscc::AcquireRequest* Arena::CreateMaybeMessage<::dscc::AcquireRequest>(Arena*);
 template<> ::dscc::AcquireResponse* Arena::CreateMaybeMessage<::dscc::AcquireResponse>(Arena*);
+template<> ::dscc::Embedding* Arena::CreateMaybeMessage<::dscc::Embedding>(Arena*);
 template<> ::dscc::PingRequest* Arena::CreateMaybeMessage<::dscc::PingRequest>(Arena*);
 template<> ::dscc::PingResponse* Arena::CreateMaybeMessage<::dscc::PingResponse>(Arena*);
 template<> ::dscc::ReleaseRequest* Arena::CreateMaybeMessage<::dscc::ReleaseRequest>(Arena*);
 template<> ::dscc::ReleaseResponse* Arena::CreateMaybeMessage<::dscc::ReleaseResponse>(Arena*);
+template<> ::dscc::RenewLeaseRequest* Arena::CreateMaybeMessage<::dscc::RenewLeaseRequest>(Arena*);
+template<> ::dscc::RenewLeaseResponse* Arena::CreateMaybeMessage<::dscc::RenewLeaseResponse>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace dscc {
 
+enum LockMode : int {
+  LOCK_MODE_EXCLUSIVE = 0,
+  LOCK_MODE_SHARED = 1,
+  LockMode_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  LockMode_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool LockMode_IsValid(int value);
+constexpr LockMode LockMode_MIN = LOCK_MODE_EXCLUSIVE;
+constexpr LockMode LockMode_MAX = LOCK_MODE_SHARED;
+constexpr int LockMode_ARRAYSIZE = LockMode_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* LockMode_descriptor();
+template<typename T>
+inline const std::string& LockMode_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, LockMode>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function LockMode_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    LockMode_descriptor(), enum_t_value);
+}
+inline bool LockMode_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, LockMode* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<LockMode>(
+    LockMode_descriptor(), name, value);
+}
 // ===================================================================
 
 class PingRequest final :
@@ -382,6 +420,167 @@ class PingResponse final :
 };
 // -------------------------------------------------------------------
 
+class Embedding final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:dscc.Embedding) */ {
+ public:
+  inline Embedding() : Embedding(nullptr) {}
+  ~Embedding() override;
+  explicit PROTOBUF_CONSTEXPR Embedding(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Embedding(const Embedding& from);
+  Embedding(Embedding&& from) noexcept
+    : Embedding() {
+    *this = ::std::move(from);
+  }
+
+  inline Embedding& operator=(const Embedding& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Embedding& operator=(Embedding&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Embedding& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Embedding* internal_default_instance() {
+    return reinterpret_cast<const Embedding*>(
+               &_Embedding_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(Embedding& a, Embedding& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Embedding* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Embedding* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Embedding* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Embedding>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Embedding& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Embedding& from) {
+    Embedding::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Embedding* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "dscc.Embedding";
+  }
+  protected:
+  explicit Embedding(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kValuesFieldNumber = 1,
+  };
+  // repeated float values = 1;
+  int values_size() const;
+  private:
+  int _internal_values_size() const;
+  public:
+  void clear_values();
+  private:
+  float _internal_values(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      _internal_values() const;
+  void _internal_add_values(float value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      _internal_mutable_values();
+  public:
+  float values(int index) const;
+  void set_values(int index, float value);
+  void add_values(float value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      values() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      mutable_values();
+
+  // @@protoc_insertion_point(class_scope:dscc.Embedding)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > values_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_dscc_2eproto;
+};
+// -------------------------------------------------------------------
+
 class AcquireRequest final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:dscc.AcquireRequest) */ {
  public:
@@ -430,7 +629,7 @@ class AcquireRequest final :
                &_AcquireRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    2;
+    3;
 
   friend void swap(AcquireRequest& a, AcquireRequest& b) {
     a.Swap(&b);
@@ -504,10 +703,14 @@ class AcquireRequest final :
 
   enum : int {
     kEmbeddingFieldNumber = 2,
+    kEmbeddingsFieldNumber = 8,
     kAgentIdFieldNumber = 1,
     kPayloadTextFieldNumber = 3,
     kSourceFileFieldNumber = 4,
     kTimestampUnixMsFieldNumber = 5,
+    kOmitBlockerDiagnosticsFieldNumber = 6,
+    kModeFieldNumber = 7,
+    kLeaseTtlMsFieldNumber = 9,
   };
   // repeated float embedding = 2;
   int embedding_size() const;
@@ -531,6 +734,24 @@ class AcquireRequest final :
   ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
       mutable_embedding();
 
+  // repeated .dscc.Embedding embeddings = 8;
+  int embeddings_size() const;
+  private:
+  int _internal_embeddings_size() const;
+  public:
+  void clear_embeddings();
+  ::dscc::Embedding* mutable_embeddings(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::dscc::Embedding >*
+      mutable_embeddings();
+  private:
+  const ::dscc::Embedding& _internal_embeddings(int index) const;
+  ::dscc::Embedding* _internal_add_embeddings();
+  public:
+  const ::dscc::Embedding& embeddings(int index) const;
+  ::dscc::Embedding* add_embeddings();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::dscc::Embedding >&
+      embeddings() const;
+
   // string agent_id = 1;
   void clear_agent_id();
   const std::string& agent_id() const;
@@ -582,6 +803,33 @@ class AcquireRequest final :
   void _internal_set_timestamp_unix_ms(int64_t value);
   public:
 
+  // bool omit_blocker_diagnostics = 6;
+  void clear_omit_blocker_diagnostics();
+  bool omit_blocker_diagnostics() const;
+  void set_omit_blocker_diagnostics(bool value);
+  private:
+  bool _internal_omit_blocker_diagnostics() const;
+  void _internal_set_omit_blocker_diagnostics(bool value);
+  public:
+
+  // .dscc.LockMode mode = 7;
+  void clear_mode();
+  ::dscc::LockMode mode() const;
+  void set_mode(::dscc::LockMode value);
+  private:
+  ::dscc::LockMode _internal_mode() const;
+  void _internal_set_mode(::dscc::LockMode value);
+  public:
+
+  // int64 lease_ttl_ms = 9;
+  void clear_lease_ttl_ms();
+  int64_t lease_ttl_ms() const;
+  void set_lease_ttl_ms(int64_t value);
+  private:
+  int64_t _internal_lease_ttl_ms() const;
+  void _internal_set_lease_ttl_ms(int64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:dscc.AcquireRequest)
  private:
   class _Internal;
@@ -591,10 +839,14 @@ class AcquireRequest final :
   typedef void DestructorSkippable_;
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > embedding_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::dscc::Embedding > embeddings_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr agent_id_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr payload_text_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr source_file_;
     int64_t timestamp_unix_ms_;
+    bool omit_blocker_diagnostics_;
+    int mode_;
+    int64_t lease_ttl_ms_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -650,7 +902,7 @@ class AcquireResponse final :
                &_AcquireResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    3;
+    4;
 
   friend void swap(AcquireResponse& a, AcquireResponse& b) {
     a.Swap(&b);
@@ -724,7 +976,16 @@ class AcquireResponse final :
 
   enum : int {
     kMessageFieldNumber = 2,
+    kBlockingAgentIdFieldNumber = 9,
+    kServerReceivedUnixMsFieldNumber = 3,
+    kLockAcquiredUnixMsFieldNumber = 4,
     kGrantedFieldNumber = 1,
+    kBlockingSimilarityScoreFieldNumber = 8,
+    kQdrantWriteCompleteUnixMsFieldNumber = 5,
+    kLockReleasedUnixMsFieldNumber = 6,
+    kLockWaitMsFieldNumber = 7,
+    kLeaseExpiresUnixMsFieldNumber = 11,
+    kQueuePositionFieldNumber = 10,
   };
   // string message = 2;
   void clear_message();
@@ -740,6 +1001,38 @@ class AcquireResponse final :
   std::string* _internal_mutable_message();
   public:
 
+  // string blocking_agent_id = 9;
+  void clear_blocking_agent_id();
+  const std::string& blocking_agent_id() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_blocking_agent_id(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_blocking_agent_id();
+  PROTOBUF_NODISCARD std::string* release_blocking_agent_id();
+  void set_allocated_blocking_agent_id(std::string* blocking_agent_id);
+  private:
+  const std::string& _internal_blocking_agent_id() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_blocking_agent_id(const std::string& value);
+  std::string* _internal_mutable_blocking_agent_id();
+  public:
+
+  // int64 server_received_unix_ms = 3;
+  void clear_server_received_unix_ms();
+  int64_t server_received_unix_ms() const;
+  void set_server_received_unix_ms(int64_t value);
+  private:
+  int64_t _internal_server_received_unix_ms() const;
+  void _internal_set_server_received_unix_ms(int64_t value);
+  public:
+
+  // int64 lock_acquired_unix_ms = 4;
+  void clear_lock_acquired_unix_ms();
+  int64_t lock_acquired_unix_ms() const;
+  void set_lock_acquired_unix_ms(int64_t value);
+  private:
+  int64_t _internal_lock_acquired_unix_ms() const;
+  void _internal_set_lock_acquired_unix_ms(int64_t value);
+  public:
+
   // bool granted = 1;
   void clear_granted();
   bool granted() const;
@@ -749,6 +1042,60 @@ class AcquireResponse final :
   void _internal_set_granted(bool value);
   public:
 
+  // float blocking_similarity_score = 8;
+  void clear_blocking_similarity_score();
+  float blocking_similarity_score() const;
+  void set_blocking_similarity_score(float value);
+  private:
+  float _internal_blocking_similarity_score() const;
+  void _internal_set_blocking_similarity_score(float value);
+  public:
+
+  // int64 qdrant_write_complete_unix_ms = 5;
+  void clear_qdrant_write_complete_unix_ms();
+  int64_t qdrant_write_complete_unix_ms() const;
+  void set_qdrant_write_complete_unix_ms(int64_t value);
+  private:
+  int64_t _internal_qdrant_write_complete_unix_ms() const;
+  void _internal_set_qdrant_write_complete_unix_ms(int64_t value);
+  public:
+
+  // int64 lock_released_unix_ms = 6;
+  void clear_lock_released_unix_ms();
+  int64_t lock_released_unix_ms() const;
+  void set_lock_released_unix_ms(int64_t value);
+  private:
+  int64_t _internal_lock_released_unix_ms() const;
+  void _internal_set_lock_released_unix_ms(int64_t value);
+  public:
+
+  // int64 lock_wait_ms = 7;
+  void clear_lock_wait_ms();
+  int64_t lock_wait_ms() const;
+  void set_lock_wait_ms(int64_t value);
+  private:
+  int64_t _internal_lock_wait_ms() const;
+  void _internal_set_lock_wait_ms(int64_t value);
+  public:
+
+  // int64 lease_expires_unix_ms = 11;
+  void clear_lease_expires_unix_ms();
+  int64_t lease_expires_unix_ms() const;
+  void set_lease_expires_unix_ms(int64_t value);
+  private:
+  int64_t _internal_lease_expires_unix_ms() const;
+  void _internal_set_lease_expires_unix_ms(int64_t value);
+  public:
+
+  // int32 queue_position = 10;
+  void clear_queue_position();
+  int32_t queue_position() const;
+  void set_queue_position(int32_t value);
+  private:
+  int32_t _internal_queue_position() const;
+  void _internal_set_queue_position(int32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:dscc.AcquireResponse)
  private:
   class _Internal;
@@ -758,7 +1105,16 @@ class AcquireResponse final :
   typedef void DestructorSkippable_;
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr blocking_agent_id_;
+    int64_t server_received_unix_ms_;
+    int64_t lock_acquired_unix_ms_;
     bool granted_;
+    float blocking_similarity_score_;
+    int64_t qdrant_write_complete_unix_ms_;
+    int64_t lock_released_unix_ms_;
+    int64_t lock_wait_ms_;
+    int64_t lease_expires_unix_ms_;
+    int32_t queue_position_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -814,7 +1170,7 @@ class ReleaseRequest final :
                &_ReleaseRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    4;
+    5;
 
   friend void swap(ReleaseRequest& a, ReleaseRequest& b) {
     a.Swap(&b);
@@ -967,7 +1323,7 @@ class ReleaseResponse final :
                &_ReleaseResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    5;
+    6;
 
   friend void swap(ReleaseResponse& a, ReleaseResponse& b) {
     a.Swap(&b);
@@ -1065,68 +1421,391 @@ class ReleaseResponse final :
   union { Impl_ _impl_; };
   friend struct ::TableStruct_dscc_2eproto;
 };
-// ===================================================================
+// -------------------------------------------------------------------
 
+class RenewLeaseRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:dscc.RenewLeaseRequest) */ {
+ public:
+  inline RenewLeaseRequest() : RenewLeaseRequest(nullptr) {}
+  ~RenewLeaseRequest() override;
+  explicit PROTOBUF_CONSTEXPR RenewLeaseRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-// ===================================================================
+  RenewLeaseRequest(const RenewLeaseRequest& from);
+  RenewLeaseRequest(RenewLeaseRequest&& from) noexcept
+    : RenewLeaseRequest() {
+    *this = ::std::move(from);
+  }
 
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// PingRequest
+  inline RenewLeaseRequest& operator=(const RenewLeaseRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RenewLeaseRequest& operator=(RenewLeaseRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
 
-// string from_node = 1;
-inline void PingRequest::clear_from_node() {
-  _impl_.from_node_.ClearToEmpty();
-}
-inline const std::string& PingRequest::from_node() const {
-  // @@protoc_insertion_point(field_get:dscc.PingRequest.from_node)
-  return _internal_from_node();
-}
-template <typename ArgT0, typename... ArgT>
-inline PROTOBUF_ALWAYS_INLINE
-void PingRequest::set_from_node(ArgT0&& arg0, ArgT... args) {
- 
- _impl_.from_node_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:dscc.PingRequest.from_node)
-}
-inline std::string* PingRequest::mutable_from_node() {
-  std::string* _s = _internal_mutable_from_node();
-  // @@protoc_insertion_point(field_mutable:dscc.PingRequest.from_node)
-  return _s;
-}
-inline const std::string& PingRequest::_internal_from_node() const {
-  return _impl_.from_node_.Get();
-}
-inline void PingRequest::_internal_set_from_node(const std::string& value) {
-  
-  _impl_.from_node_.Set(value, GetArenaForAllocation());
-}
-inline std::string* PingRequest::_internal_mutable_from_node() {
-  
-  return _impl_.from_node_.Mutable(GetArenaForAllocation());
-}
-inline std::string* PingRequest::release_from_node() {
-  // @@protoc_insertion_point(field_release:dscc.PingRequest.from_node)
-  return _impl_.from_node_.Release();
-}
-inline void PingRequest::set_allocated_from_node(std::string* from_node) {
-  if (from_node != nullptr) {
-    
-  } else {
-    
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
   }
-  _impl_.from_node_.SetAllocated(from_node, GetArenaForAllocation());
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.from_node_.IsDefault()) {
-    _impl_.from_node_.Set("", GetArenaForAllocation());
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
   }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:dscc.PingRequest.from_node)
-}
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RenewLeaseRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RenewLeaseRequest* internal_default_instance() {
+    return reinterpret_cast<const RenewLeaseRequest*>(
+               &_RenewLeaseRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    7;
 
-// -------------------------------------------------------------------
+  friend void swap(RenewLeaseRequest& a, RenewLeaseRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RenewLeaseRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RenewLeaseRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RenewLeaseRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RenewLeaseRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RenewLeaseRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RenewLeaseRequest& from) {
+    RenewLeaseRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RenewLeaseRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "dscc.RenewLeaseRequest";
+  }
+  protected:
+  explicit RenewLeaseRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kAgentIdFieldNumber = 1,
+    kLeaseTtlMsFieldNumber = 2,
+  };
+  // string agent_id = 1;
+  void clear_agent_id();
+  const std::string& agent_id() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_agent_id(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_agent_id();
+  PROTOBUF_NODISCARD std::string* release_agent_id();
+  void set_allocated_agent_id(std::string* agent_id);
+  private:
+  const std::string& _internal_agent_id() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_agent_id(const std::string& value);
+  std::string* _internal_mutable_agent_id();
+  public:
+
+  // int64 lease_ttl_ms = 2;
+  void clear_lease_ttl_ms();
+  int64_t lease_ttl_ms() const;
+  void set_lease_ttl_ms(int64_t value);
+  private:
+  int64_t _internal_lease_ttl_ms() const;
+  void _internal_set_lease_ttl_ms(int64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:dscc.RenewLeaseRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr agent_id_;
+    int64_t lease_ttl_ms_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_dscc_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RenewLeaseResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:dscc.RenewLeaseResponse) */ {
+ public:
+  inline RenewLeaseResponse() : RenewLeaseResponse(nullptr) {}
+  ~RenewLeaseResponse() override;
+  explicit PROTOBUF_CONSTEXPR RenewLeaseResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RenewLeaseResponse(const RenewLeaseResponse& from);
+  RenewLeaseResponse(RenewLeaseResponse&& from) noexcept
+    : RenewLeaseResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline RenewLeaseResponse& operator=(const RenewLeaseResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RenewLeaseResponse& operator=(RenewLeaseResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RenewLeaseResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RenewLeaseResponse* internal_default_instance() {
+    return reinterpret_cast<const RenewLeaseResponse*>(
+               &_RenewLeaseResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(RenewLeaseResponse& a, RenewLeaseResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RenewLeaseResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RenewLeaseResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RenewLeaseResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RenewLeaseResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RenewLeaseResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RenewLeaseResponse& from) {
+    RenewLeaseResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RenewLeaseResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "dscc.RenewLeaseResponse";
+  }
+  protected:
+  explicit RenewLeaseResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kLeaseExpiresUnixMsFieldNumber = 2,
+    kRenewedFieldNumber = 1,
+  };
+  // int64 lease_expires_unix_ms = 2;
+  void clear_lease_expires_unix_ms();
+  int64_t lease_expires_unix_ms() const;
+  void set_lease_expires_unix_ms(int64_t value);
+  private:
+  int64_t _internal_lease_expires_unix_ms() const;
+  void _internal_set_lease_expires_unix_ms(int64_t value);
+  public:
+
+  // bool renewed = 1;
+  void clear_renewed();
+  bool renewed() const;
+  void set_renewed(bool value);
+  private:
+  bool _internal_renewed() const;
+  void _internal_set_renewed(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:dscc.RenewLeaseResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    int64_t lease_expires_unix_ms_;
+    bool renewed_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_dscc_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// PingRequest
+
+// string from_node = 1;
+inline void PingRequest::clear_from_node() {
+  _impl_.from_node_.ClearToEmpty();
+}
+inline const std::string& PingRequest::from_node() const {
+  // @@protoc_insertion_point(field_get:dscc.PingRequest.from_node)
+  return _internal_from_node();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void PingRequest::set_from_node(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.from_node_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:dscc.PingRequest.from_node)
+}
+inline std::string* PingRequest::mutable_from_node() {
+  std::string* _s = _internal_mutable_from_node();
+  // @@protoc_insertion_point(field_mutable:dscc.PingRequest.from_node)
+  return _s;
+}
+inline const std::string& PingRequest::_internal_from_node() const {
+  return _impl_.from_node_.Get();
+}
+inline void PingRequest::_internal_set_from_node(const std::string& value) {
+  
+  _impl_.from_node_.Set(value, GetArenaForAllocation());
+}
+inline std::string* PingRequest::_internal_mutable_from_node() {
+  
+  return _impl_.from_node_.Mutable(GetArenaForAllocation());
+}
+inline std::string* PingRequest::release_from_node() {
+  // @@protoc_insertion_point(field_release:dscc.PingRequest.from_node)
+  return _impl_.from_node_.Release();
+}
+inline void PingRequest::set_allocated_from_node(std::string* from_node) {
+  if (from_node != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.from_node_.SetAllocated(from_node, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.from_node_.IsDefault()) {
+    _impl_.from_node_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:dscc.PingRequest.from_node)
+}
+
+// -------------------------------------------------------------------
 
 // PingResponse
 
@@ -1182,6 +1861,57 @@ inline void PingResponse::set_allocated_message(std::string* message) {
 
 // -------------------------------------------------------------------
 
+// Embedding
+
+// repeated float values = 1;
+inline int Embedding::_internal_values_size() const {
+  return _impl_.values_.size();
+}
+inline int Embedding::values_size() const {
+  return _internal_values_size();
+}
+inline void Embedding::clear_values() {
+  _impl_.values_.Clear();
+}
+inline float Embedding::_internal_values(int index) const {
+  return _impl_.values_.Get(index);
+}
+inline float Embedding::values(int index) const {
+  // @@protoc_insertion_point(field_get:dscc.Embedding.values)
+  return _internal_values(index);
+}
+inline void Embedding::set_values(int index, float value) {
+  _impl_.values_.Set(index, value);
+  // @@protoc_insertion_point(field_set:dscc.Embedding.values)
+}
+inline void Embedding::_internal_add_values(float value) {
+  _impl_.values_.Add(value);
+}
+inline void Embedding::add_values(float value) {
+  _internal_add_values(value);
+  // @@protoc_insertion_point(field_add:dscc.Embedding.values)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+Embedding::_internal_values() const {
+  return _impl_.values_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+Embedding::values() const {
+  // @@protoc_insertion_point(field_list:dscc.Embedding.values)
+  return _internal_values();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+Embedding::_internal_mutable_values() {
+  return &_impl_.values_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+Embedding::mutable_values() {
+  // @@protoc_insertion_point(field_mutable_list:dscc.Embedding.values)
+  return _internal_mutable_values();
+}
+
+// -------------------------------------------------------------------
+
 // AcquireRequest
 
 // string agent_id = 1;
@@ -1401,6 +2131,106 @@ inline void AcquireRequest::set_timestamp_unix_ms(int64_t value) {
   // @@protoc_insertion_point(field_set:dscc.AcquireRequest.timestamp_unix_ms)
 }
 
+// bool omit_blocker_diagnostics = 6;
+inline void AcquireRequest::clear_omit_blocker_diagnostics() {
+  _impl_.omit_blocker_diagnostics_ = false;
+}
+inline bool AcquireRequest::_internal_omit_blocker_diagnostics() const {
+  return _impl_.omit_blocker_diagnostics_;
+}
+inline bool AcquireRequest::omit_blocker_diagnostics() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireRequest.omit_blocker_diagnostics)
+  return _internal_omit_blocker_diagnostics();
+}
+inline void AcquireRequest::_internal_set_omit_blocker_diagnostics(bool value) {
+  
+  _impl_.omit_blocker_diagnostics_ = value;
+}
+inline void AcquireRequest::set_omit_blocker_diagnostics(bool value) {
+  _internal_set_omit_blocker_diagnostics(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireRequest.omit_blocker_diagnostics)
+}
+
+// .dscc.LockMode mode = 7;
+inline void AcquireRequest::clear_mode() {
+  _impl_.mode_ = 0;
+}
+inline ::dscc::LockMode AcquireRequest::_internal_mode() const {
+  return static_cast< ::dscc::LockMode >(_impl_.mode_);
+}
+inline ::dscc::LockMode AcquireRequest::mode() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireRequest.mode)
+  return _internal_mode();
+}
+inline void AcquireRequest::_internal_set_mode(::dscc::LockMode value) {
+  
+  _impl_.mode_ = value;
+}
+inline void AcquireRequest::set_mode(::dscc::LockMode value) {
+  _internal_set_mode(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireRequest.mode)
+}
+
+// repeated .dscc.Embedding embeddings = 8;
+inline int AcquireRequest::_internal_embeddings_size() const {
+  return _impl_.embeddings_.size();
+}
+inline int AcquireRequest::embeddings_size() const {
+  return _internal_embeddings_size();
+}
+inline void AcquireRequest::clear_embeddings() {
+  _impl_.embeddings_.Clear();
+}
+inline ::dscc::Embedding* AcquireRequest::mutable_embeddings(int index) {
+  // @@protoc_insertion_point(field_mutable:dscc.AcquireRequest.embeddings)
+  return _impl_.embeddings_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::dscc::Embedding >*
+AcquireRequest::mutable_embeddings() {
+  // @@protoc_insertion_point(field_mutable_list:dscc.AcquireRequest.embeddings)
+  return &_impl_.embeddings_;
+}
+inline const ::dscc::Embedding& AcquireRequest::_internal_embeddings(int index) const {
+  return _impl_.embeddings_.Get(index);
+}
+inline const ::dscc::Embedding& AcquireRequest::embeddings(int index) const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireRequest.embeddings)
+  return _internal_embeddings(index);
+}
+inline ::dscc::Embedding* AcquireRequest::_internal_add_embeddings() {
+  return _impl_.embeddings_.Add();
+}
+inline ::dscc::Embedding* AcquireRequest::add_embeddings() {
+  ::dscc::Embedding* _add = _internal_add_embeddings();
+  // @@protoc_insertion_point(field_add:dscc.AcquireRequest.embeddings)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::dscc::Embedding >&
+AcquireRequest::embeddings() const {
+  // @@protoc_insertion_point(field_list:dscc.AcquireRequest.embeddings)
+  return _impl_.embeddings_;
+}
+
+// int64 lease_ttl_ms = 9;
+inline void AcquireRequest::clear_lease_ttl_ms() {
+  _impl_.lease_ttl_ms_ = int64_t{0};
+}
+inline int64_t AcquireRequest::_internal_lease_ttl_ms() const {
+  return _impl_.lease_ttl_ms_;
+}
+inline int64_t AcquireRequest::lease_ttl_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireRequest.lease_ttl_ms)
+  return _internal_lease_ttl_ms();
+}
+inline void AcquireRequest::_internal_set_lease_ttl_ms(int64_t value) {
+  
+  _impl_.lease_ttl_ms_ = value;
+}
+inline void AcquireRequest::set_lease_ttl_ms(int64_t value) {
+  _internal_set_lease_ttl_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireRequest.lease_ttl_ms)
+}
+
 // -------------------------------------------------------------------
 
 // AcquireResponse
@@ -1475,6 +2305,216 @@ inline void AcquireResponse::set_allocated_message(std::string* message) {
   // @@protoc_insertion_point(field_set_allocated:dscc.AcquireResponse.message)
 }
 
+// int64 server_received_unix_ms = 3;
+inline void AcquireResponse::clear_server_received_unix_ms() {
+  _impl_.server_received_unix_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_server_received_unix_ms() const {
+  return _impl_.server_received_unix_ms_;
+}
+inline int64_t AcquireResponse::server_received_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.server_received_unix_ms)
+  return _internal_server_received_unix_ms();
+}
+inline void AcquireResponse::_internal_set_server_received_unix_ms(int64_t value) {
+  
+  _impl_.server_received_unix_ms_ = value;
+}
+inline void AcquireResponse::set_server_received_unix_ms(int64_t value) {
+  _internal_set_server_received_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.server_received_unix_ms)
+}
+
+// int64 lock_acquired_unix_ms = 4;
+inline void AcquireResponse::clear_lock_acquired_unix_ms() {
+  _impl_.lock_acquired_unix_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_lock_acquired_unix_ms() const {
+  return _impl_.lock_acquired_unix_ms_;
+}
+inline int64_t AcquireResponse::lock_acquired_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.lock_acquired_unix_ms)
+  return _internal_lock_acquired_unix_ms();
+}
+inline void AcquireResponse::_internal_set_lock_acquired_unix_ms(int64_t value) {
+  
+  _impl_.lock_acquired_unix_ms_ = value;
+}
+inline void AcquireResponse::set_lock_acquired_unix_ms(int64_t value) {
+  _internal_set_lock_acquired_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.lock_acquired_unix_ms)
+}
+
+// int64 qdrant_write_complete_unix_ms = 5;
+inline void AcquireResponse::clear_qdrant_write_complete_unix_ms() {
+  _impl_.qdrant_write_complete_unix_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_qdrant_write_complete_unix_ms() const {
+  return _impl_.qdrant_write_complete_unix_ms_;
+}
+inline int64_t AcquireResponse::qdrant_write_complete_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.qdrant_write_complete_unix_ms)
+  return _internal_qdrant_write_complete_unix_ms();
+}
+inline void AcquireResponse::_internal_set_qdrant_write_complete_unix_ms(int64_t value) {
+  
+  _impl_.qdrant_write_complete_unix_ms_ = value;
+}
+inline void AcquireResponse::set_qdrant_write_complete_unix_ms(int64_t value) {
+  _internal_set_qdrant_write_complete_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.qdrant_write_complete_unix_ms)
+}
+
+// int64 lock_released_unix_ms = 6;
+inline void AcquireResponse::clear_lock_released_unix_ms() {
+  _impl_.lock_released_unix_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_lock_released_unix_ms() const {
+  return _impl_.lock_released_unix_ms_;
+}
+inline int64_t AcquireResponse::lock_released_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.lock_released_unix_ms)
+  return _internal_lock_released_unix_ms();
+}
+inline void AcquireResponse::_internal_set_lock_released_unix_ms(int64_t value) {
+  
+  _impl_.lock_released_unix_ms_ = value;
+}
+inline void AcquireResponse::set_lock_released_unix_ms(int64_t value) {
+  _internal_set_lock_released_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.lock_released_unix_ms)
+}
+
+// int64 lock_wait_ms = 7;
+inline void AcquireResponse::clear_lock_wait_ms() {
+  _impl_.lock_wait_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_lock_wait_ms() const {
+  return _impl_.lock_wait_ms_;
+}
+inline int64_t AcquireResponse::lock_wait_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.lock_wait_ms)
+  return _internal_lock_wait_ms();
+}
+inline void AcquireResponse::_internal_set_lock_wait_ms(int64_t value) {
+  
+  _impl_.lock_wait_ms_ = value;
+}
+inline void AcquireResponse::set_lock_wait_ms(int64_t value) {
+  _internal_set_lock_wait_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.lock_wait_ms)
+}
+
+// float blocking_similarity_score = 8;
+inline void AcquireResponse::clear_blocking_similarity_score() {
+  _impl_.blocking_similarity_score_ = 0;
+}
+inline float AcquireResponse::_internal_blocking_similarity_score() const {
+  return _impl_.blocking_similarity_score_;
+}
+inline float AcquireResponse::blocking_similarity_score() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.blocking_similarity_score)
+  return _internal_blocking_similarity_score();
+}
+inline void AcquireResponse::_internal_set_blocking_similarity_score(float value) {
+  
+  _impl_.blocking_similarity_score_ = value;
+}
+inline void AcquireResponse::set_blocking_similarity_score(float value) {
+  _internal_set_blocking_similarity_score(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.blocking_similarity_score)
+}
+
+// string blocking_agent_id = 9;
+inline void AcquireResponse::clear_blocking_agent_id() {
+  _impl_.blocking_agent_id_.ClearToEmpty();
+}
+inline const std::string& AcquireResponse::blocking_agent_id() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.blocking_agent_id)
+  return _internal_blocking_agent_id();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void AcquireResponse::set_blocking_agent_id(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.blocking_agent_id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.blocking_agent_id)
+}
+inline std::string* AcquireResponse::mutable_blocking_agent_id() {
+  std::string* _s = _internal_mutable_blocking_agent_id();
+  // @@protoc_insertion_point(field_mutable:dscc.AcquireResponse.blocking_agent_id)
+  return _s;
+}
+inline const std::string& AcquireResponse::_internal_blocking_agent_id() const {
+  return _impl_.blocking_agent_id_.Get();
+}
+inline void AcquireResponse::_internal_set_blocking_agent_id(const std::string& value) {
+  
+  _impl_.blocking_agent_id_.Set(value, GetArenaForAllocation());
+}
+inline std::string* AcquireResponse::_internal_mutable_blocking_agent_id() {
+  
+  return _impl_.blocking_agent_id_.Mutable(GetArenaForAllocation());
+}
+inline std::string* AcquireResponse::release_blocking_agent_id() {
+  // @@protoc_insertion_point(field_release:dscc.AcquireResponse.blocking_agent_id)
+  return _impl_.blocking_agent_id_.Release();
+}
+inline void AcquireResponse::set_allocated_blocking_agent_id(std::string* blocking_agent_id) {
+  if (blocking_agent_id != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.blocking_agent_id_.SetAllocated(blocking_agent_id, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.blocking_agent_id_.IsDefault()) {
+    _impl_.blocking_agent_id_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:dscc.AcquireResponse.blocking_agent_id)
+}
+
+// int32 queue_position = 10;
+inline void AcquireResponse::clear_queue_position() {
+  _impl_.queue_position_ = 0;
+}
+inline int32_t AcquireResponse::_internal_queue_position() const {
+  return _impl_.queue_position_;
+}
+inline int32_t AcquireResponse::queue_position() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.queue_position)
+  return _internal_queue_position();
+}
+inline void AcquireResponse::_internal_set_queue_position(int32_t value) {
+  
+  _impl_.queue_position_ = value;
+}
+inline void AcquireResponse::set_queue_position(int32_t value) {
+  _internal_set_queue_position(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.queue_position)
+}
+
+// int64 lease_expires_unix_ms = 11;
+inline void AcquireResponse::clear_lease_expires_unix_ms() {
+  _impl_.lease_expires_unix_ms_ = int64_t{0};
+}
+inline int64_t AcquireResponse::_internal_lease_expires_unix_ms() const {
+  return _impl_.lease_expires_unix_ms_;
+}
+inline int64_t AcquireResponse::lease_expires_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.AcquireResponse.lease_expires_unix_ms)
+  return _internal_lease_expires_unix_ms();
+}
+inline void AcquireResponse::_internal_set_lease_expires_unix_ms(int64_t value) {
+  
+  _impl_.lease_expires_unix_ms_ = value;
+}
+inline void AcquireResponse::set_lease_expires_unix_ms(int64_t value) {
+  _internal_set_lease_expires_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.AcquireResponse.lease_expires_unix_ms)
+}
+
 // -------------------------------------------------------------------
 
 // ReleaseRequest
@@ -1553,6 +2593,124 @@ inline void ReleaseResponse::set_success(bool value) {
   // @@protoc_insertion_point(field_set:dscc.ReleaseResponse.success)
 }
 
+// -------------------------------------------------------------------
+
+// RenewLeaseRequest
+
+// string agent_id = 1;
+inline void RenewLeaseRequest::clear_agent_id() {
+  _impl_.agent_id_.ClearToEmpty();
+}
+inline const std::string& RenewLeaseRequest::agent_id() const {
+  // @@protoc_insertion_point(field_get:dscc.RenewLeaseRequest.agent_id)
+  return _internal_agent_id();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RenewLeaseRequest::set_agent_id(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.agent_id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:dscc.RenewLeaseRequest.agent_id)
+}
+inline std::string* RenewLeaseRequest::mutable_agent_id() {
+  std::string* _s = _internal_mutable_agent_id();
+  // @@protoc_insertion_point(field_mutable:dscc.RenewLeaseRequest.agent_id)
+  return _s;
+}
+inline const std::string& RenewLeaseRequest::_internal_agent_id() const {
+  return _impl_.agent_id_.Get();
+}
+inline void RenewLeaseRequest::_internal_set_agent_id(const std::string& value) {
+  
+  _impl_.agent_id_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RenewLeaseRequest::_internal_mutable_agent_id() {
+  
+  return _impl_.agent_id_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RenewLeaseRequest::release_agent_id() {
+  // @@protoc_insertion_point(field_release:dscc.RenewLeaseRequest.agent_id)
+  return _impl_.agent_id_.Release();
+}
+inline void RenewLeaseRequest::set_allocated_agent_id(std::string* agent_id) {
+  if (agent_id != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.agent_id_.SetAllocated(agent_id, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.agent_id_.IsDefault()) {
+    _impl_.agent_id_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:dscc.RenewLeaseRequest.agent_id)
+}
+
+// int64 lease_ttl_ms = 2;
+inline void RenewLeaseRequest::clear_lease_ttl_ms() {
+  _impl_.lease_ttl_ms_ = int64_t{0};
+}
+inline int64_t RenewLeaseRequest::_internal_lease_ttl_ms() const {
+  return _impl_.lease_ttl_ms_;
+}
+inline int64_t RenewLeaseRequest::lease_ttl_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.RenewLeaseRequest.lease_ttl_ms)
+  return _internal_lease_ttl_ms();
+}
+inline void RenewLeaseRequest::_internal_set_lease_ttl_ms(int64_t value) {
+  
+  _impl_.lease_ttl_ms_ = value;
+}
+inline void RenewLeaseRequest::set_lease_ttl_ms(int64_t value) {
+  _internal_set_lease_ttl_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.RenewLeaseRequest.lease_ttl_ms)
+}
+
+// -------------------------------------------------------------------
+
+// RenewLeaseResponse
+
+// bool renewed = 1;
+inline void RenewLeaseResponse::clear_renewed() {
+  _impl_.renewed_ = false;
+}
+inline bool RenewLeaseResponse::_internal_renewed() const {
+  return _impl_.renewed_;
+}
+inline bool RenewLeaseResponse::renewed() const {
+  // @@protoc_insertion_point(field_get:dscc.RenewLeaseResponse.renewed)
+  return _internal_renewed();
+}
+inline void RenewLeaseResponse::_internal_set_renewed(bool value) {
+  
+  _impl_.renewed_ = value;
+}
+inline void RenewLeaseResponse::set_renewed(bool value) {
+  _internal_set_renewed(value);
+  // @@protoc_insertion_point(field_set:dscc.RenewLeaseResponse.renewed)
+}
+
+// int64 lease_expires_unix_ms = 2;
+inline void RenewLeaseResponse::clear_lease_expires_unix_ms() {
+  _impl_.lease_expires_unix_ms_ = int64_t{0};
+}
+inline int64_t RenewLeaseResponse::_internal_lease_expires_unix_ms() const {
+  return _impl_.lease_expires_unix_ms_;
+}
+inline int64_t RenewLeaseResponse::lease_expires_unix_ms() const {
+  // @@protoc_insertion_point(field_get:dscc.RenewLeaseResponse.lease_expires_unix_ms)
+  return _internal_lease_expires_unix_ms();
+}
+inline void RenewLeaseResponse::_internal_set_lease_expires_unix_ms(int64_t value) {
+  
+  _impl_.lease_expires_unix_ms_ = value;
+}
+inline void RenewLeaseResponse::set_lease_expires_unix_ms(int64_t value) {
+  _internal_set_lease_expires_unix_ms(value);
+  // @@protoc_insertion_point(field_set:dscc.RenewLeaseResponse.lease_expires_unix_ms)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1566,11 +2724,27 @@ inline void ReleaseResponse::set_success(bool value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
 }  // namespace dscc
 
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::dscc::LockMode> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::dscc::LockMode>() {
+  return ::dscc::LockMode_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
 // @@protoc_insertion_point(global_scope)
 
 #include <google/protobuf/port_undef.inc>
@@ -3,72 +3,481 @@
 // lock_service_impl.cpp calls into this file before any Qdrant write happens.
 
 #include "active_lock_table.h"
+#include "similarity_kernels.h"
 #include "threadsafe_log.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 #include <sstream>
+#include <tuple>
+
+namespace {
+
+// Fixed so every node places a centroid in the same shard.
+constexpr uint64_t kShardSeed = 0x5d4c4c5348415244ULL;
+constexpr size_t kMaxShardBits = 8;
+// How often a waiter with a cancellation check wakes up to poll it.
+constexpr std::chrono::milliseconds kCancelPollInterval{50};
+constexpr size_t kMaxPivots = 64;
+// Added to the pivot and cluster pruning radii so float error in the stored
+// angles can only keep a row, never skip a conflict.
+constexpr float kPivotSlack = 1e-3f;
+// admit_batch's matrix sums in another order than dot_; entries this close
+// to a waiter's floor are recomputed with dot_, so a pair at theta is
+// decided as check_row decides it.
+constexpr float kMatrixSlack = 1e-3f;
+// A new pivot must be at least this far from the existing ones; pivots
+// inside one cluster prune little that the first one does not.
+constexpr float kPivotMaxSimilarity = 0.5f;
+constexpr size_t kPartitionsPerThread = 4;
+// How many of a shard's newest clusters a new lock is compared with, at one
+// dot product each.
+constexpr size_t kOpenClusters = 8;
+
+float clamped_angle(float dot) {
+    return std::acos(std::max(-1.0f, std::min(1.0f, dot)));
+}
+
+bool modes_conflict(LockMode a, LockMode b) {
+    return a == LockMode::kExclusive || b == LockMode::kExclusive;
+}
+
+}  // namespace
+
+ActiveLockTable::ActiveLockTable(const ActiveLockTableOptions& options)
+    : options_(options) {
+    options_.shard_bits = std::min(options_.shard_bits, kMaxShardBits);
+    options_.pivot_count = std::min(options_.pivot_count, kMaxPivots);
+    options_.lease_tick = std::max(options_.lease_tick, std::chrono::milliseconds(1));
+    lease_origin_ = Clock::now();
+    if (!(options_.cluster_similarity > 0.0f && options_.cluster_similarity <= 1.0f)) {
+        options_.cluster_similarity = 0.0f;
+    }
+    for (ConcurrencyBand& band : options_.concurrency_bands) {
+        band.max_holders = std::max<size_t>(band.max_holders, 1);
+    }
+    shards_.resize(size_t{1} << options_.shard_bits);
+    for (auto& shard : shards_) {
+        shard = std::make_unique<Shard>();
+    }
+    if (options_.parallel_scan_threads > 0) {
+        scan_pool_ = std::make_unique<ScanPool>(options_.parallel_scan_threads);
+    }
+}
+
+ActiveLockTable::~ActiveLockTable() {
+    {
+        std::lock_guard<std::mutex> lease_lock(lease_mu_);
+        reaper_stopping_ = true;
+    }
+    reaper_cv_.notify_all();
+    if (reaper_.joinable()) {
+        reaper_.join();
+    }
+}
 
 AcquireTrace ActiveLockTable::acquire(const std::string& agent_id,
                                       const std::vector<float>& embedding,
-                                      float threshold) {
-    std::unique_lock<std::mutex> lock(mu_);
-    AcquireTrace aggregate_trace;
-    while (true) {
-        const AcquireTrace overlap = overlap_trace(embedding, threshold);
-        if (!overlap.waited) {
+                                      float threshold,
+                                      LockMode mode) {
+    return acquire_until(agent_id, embedding, threshold, Clock::time_point::max(),
+                         CancelCheck(), true, mode);
+}
+
+AcquireTrace ActiveLockTable::acquire_for(const std::string& agent_id,
+                                          const std::vector<float>& embedding,
+                                          float threshold,
+                                          Clock::duration timeout,
+                                          const CancelCheck& cancelled) {
+    return acquire_until(agent_id, embedding, threshold, Clock::now() + timeout, cancelled);
+}
+
+AcquireTrace ActiveLockTable::acquire_until(const std::string& agent_id,
+                                            const std::vector<float>& embedding,
+                                            float threshold,
+                                            Clock::time_point deadline,
+                                            const CancelCheck& cancelled,
+                                            bool diagnostics,
+                                            LockMode mode) {
+    return acquire_embeddings(agent_id, {&embedding}, threshold, deadline, cancelled,
+                              diagnostics, mode);
+}
+
+AcquireTrace ActiveLockTable::acquire_all_until(const std::string& agent_id,
+                                                const std::vector<std::vector<float>>& embeddings,
+                                                float threshold,
+                                                Clock::time_point deadline,
+                                                const CancelCheck& cancelled,
+                                                bool diagnostics,
+                                                LockMode mode) {
+    std::vector<const std::vector<float>*> parts;
+    parts.reserve(embeddings.size());
+    for (const std::vector<float>& embedding : embeddings) {
+        parts.push_back(&embedding);
+    }
+    return acquire_embeddings(agent_id, std::move(parts), threshold, deadline, cancelled,
+                              diagnostics, mode);
+}
+
+AcquireTrace ActiveLockTable::acquire_embeddings(const std::string& agent_id,
+                                                 std::vector<const std::vector<float>*> embeddings,
+                                                 float threshold,
+                                                 Clock::time_point deadline,
+                                                 const CancelCheck& cancelled,
+                                                 bool diagnostics,
+                                                 LockMode mode) {
+    Waiter waiter;
+    waiter.agent_id = &agent_id;
+    waiter.embeddings = std::move(embeddings);
+    waiter.threshold = threshold;
+    waiter.floor = counting_floor(threshold);
+    waiter.mode = mode;
+    waiter.deadline = deadline;
+    if (misses_deadline(deadline, Clock::now())) {
+        log_line("[LOCK] " + agent_id + " shed on arrival: deadline cannot be met");
+        waiter.trace.status = AcquireStatus::kDeadlineExceeded;
+        return waiter.trace;
+    }
+    std::vector<BlockingHit> hits;
+    std::vector<std::unique_lock<std::mutex>> shard_locks;
+    std::vector<std::shared_ptr<const ShardSnapshot>> snapshots;
+    std::vector<ScanQuery> queries;
+    const bool first_conflict_only = !diagnostics && options_.concurrency_bands.empty();
+
+    std::shared_lock<std::shared_mutex> layout(layout_mu_);
+    for (const std::vector<float>* embedding : waiter.embeddings) {
+        while (dimension_ != embedding->size()) {
+            if (dimension_ != 0) {
+                waiter.trace.status = AcquireStatus::kDimensionMismatch;
+                waiter.trace.table_dimension = dimension_;
+                return waiter.trace;
+            }
+            layout.unlock();
+            adopt_dimension(embedding->size());
+            layout.lock();
+        }
+    }
+
+    // Every shard that any of the embeddings could conflict in.
+    std::vector<size_t>& probe = waiter.probe;
+    std::vector<size_t> embedding_probe;
+    for (const std::vector<float>* embedding : waiter.embeddings) {
+        sharder_.probe_shards(embedding->data(), waiter.floor, embedding_probe);
+        probe.insert(probe.end(), embedding_probe.begin(), embedding_probe.end());
+    }
+    std::sort(probe.begin(), probe.end());
+    probe.erase(std::unique(probe.begin(), probe.end()), probe.end());
+    prepare_queries(waiter, first_conflict_only, queries);
+
+    // First pass: scan the published snapshots without any shard mutex,
+    // so releases and inserts are never held up behind a long scan.
+    // Shards large enough for their index are searched under the mutex
+    // below instead, since the index is not snapshotted.
+    // Big shards are split across the scan pool. Without diagnostics the
+    // scans stop at the first conflict; `partial` marks the snapshots that
+    // were not scanned to the end.
+    std::vector<bool> partial(probe.size(), false);
+    for (size_t i = 0; i < probe.size(); ++i) {
+        const size_t index = probe[i];
+        std::shared_ptr<const ShardSnapshot> snapshot = load_snapshot(*shards_[index]);
+        if (use_index(*shards_[index], snapshot->rows)) {
+            snapshot.reset();
+        } else if (first_conflict_only && !hits.empty()) {
+            partial[i] = true;
+        } else if (scan_pool_ != nullptr && snapshot->rows >= options_.parallel_scan_min_locks) {
+            partial[i] = !scan_snapshot_parallel(*snapshot, index, queries, hits);
+        } else {
+            partial[i] = !scan_snapshot(*snapshot, index, queries, hits);
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+
+    // Lock every shard a conflicting lock could live in, in ascending
+    // order so concurrent acquires cannot deadlock.
+    for (const size_t index : probe) {
+        shard_locks.emplace_back(shards_[index]->mu);
+    }
+
+    // Validate: drop snapshot hits that were released meanwhile, then
+    // check only the locks inserted after each snapshot was taken. A
+    // snapshot that was cut short says nothing about the rows it skipped,
+    // so if its conflicts are all gone the shard is scanned in full.
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [this](const BlockingHit& hit) {
+                                  return shards_[hit.ref.shard]->row_of_lock.count(
+                                             hit.ref.lock_id) == 0;
+                              }),
+               hits.end());
+    for (size_t i = 0; i < probe.size(); ++i) {
+        if (first_conflict_only && !hits.empty()) {
             break;
         }
+        const uint64_t since =
+            snapshots[i] != nullptr && !partial[i] ? snapshots[i]->epoch : 0;
+        scan_shard(*shards_[probe[i]], probe[i], queries, since, hits);
+    }
+    // With an early stop only some blockers are known.
+    const bool complete = !first_conflict_only || hits.empty();
+    const bool recount = keep_blocking_hits(hits, threshold);
+    record_scan_stats(queries);
+
+    std::vector<QueuedHit> ahead;
+    if (tracks_intents()) {
+        find_queued_ahead(waiter, ahead);
+    }
 
-        aggregate_trace.waited = true;
-        if (overlap.blocking_similarity_score >= aggregate_trace.blocking_similarity_score) {
-            aggregate_trace.blocking_similarity_score = overlap.blocking_similarity_score;
-            aggregate_trace.blocking_agent_id = overlap.blocking_agent_id;
+    if (hits.empty() && ahead.empty()) {
+        std::vector<size_t> touched;
+        for (const std::vector<float>* embedding : waiter.embeddings) {
+            const LockRef ref = insert_lock(agent_id, *embedding, threshold, mode);
+            waiter.trace.lock_ids.push_back(ref.lock_id);
+            touched.push_back(ref.shard);
         }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (const size_t index : touched) {
+            publish_snapshot(*shards_[index]);
+        }
+        shard_locks.clear();
+        layout.unlock();
+        print_active_locks();
+        return waiter.trace;
+    }
 
-        std::ostringstream oss;
-        oss << "[LOCK] " << agent_id
-            << " blocked by " << overlap.blocking_agent_id
-            << " similarity=" << std::fixed << std::setprecision(3)
-            << overlap.blocking_similarity_score
-            << " threshold=" << threshold;
-        log_line(oss.str());
-        cv_.wait(lock);
+    // From here on the releases decide: the one that clears the last
+    // blocker re-checks this waiter together with every other waiter it
+    // freed, and inserts the lock for it once nothing else is in the way.
+    // After an early stop, or when it waits on only some holders in a band,
+    // the first admission check covers every lock rather than just newer
+    // ones.
+    waiter.scanned_epoch = complete && !recount ? next_epoch_.load() : 0;
+    waiter.diagnostics = diagnostics;
+    waiter.arrival = next_arrival_.fetch_add(1);
+    waiter.trace.queue_position = ahead.size();
+    if (tracks_intents()) {
+        // The home shards are among the probed shards, so they are locked.
+        for (const std::vector<float>* embedding : waiter.embeddings) {
+            waiter.homes.push_back(sharder_.home_shard(embedding->data()));
+        }
+        std::sort(waiter.homes.begin(), waiter.homes.end());
+        waiter.homes.erase(std::unique(waiter.homes.begin(), waiter.homes.end()),
+                           waiter.homes.end());
+        for (const size_t home : waiter.homes) {
+            shards_[home]->intents.push_back(&waiter);
+        }
     }
+    block_waiter(waiter, hits, ahead);
+    shard_locks.clear();
+    layout.unlock();
 
-    active_.push_back(SemanticLock{agent_id, embedding, threshold});
-    lock.unlock();
-    print_active_locks();
-    return aggregate_trace;
+    // Past this point the request would be shed anyway.
+    const Clock::time_point give_up = deadline == Clock::time_point::max()
+        ? deadline
+        : deadline - options_.deadline_slack;
+    AcquireStatus gave_up = AcquireStatus::kGranted;
+    {
+        std::unique_lock<std::mutex> waiter_lock(waiter.mu);
+        while (!waiter.decided) {
+            Clock::time_point wake = give_up;
+            if (cancelled) {
+                wake = std::min(wake, Clock::now() + kCancelPollInterval);
+            }
+            if (wake == Clock::time_point::max()) {
+                waiter.cv.wait(waiter_lock);
+                continue;
+            }
+            waiter.cv.wait_until(waiter_lock, wake);
+            if (waiter.decided) {
+                break;
+            }
+            if (Clock::now() >= give_up) {
+                gave_up = AcquireStatus::kDeadlineExceeded;
+                break;
+            }
+            if (cancelled && cancelled()) {
+                gave_up = AcquireStatus::kCancelled;
+                break;
+            }
+        }
+    }
+    if (gave_up != AcquireStatus::kGranted) {
+        if (abandon_waiter(waiter)) {
+            log_line("[LOCK] " + agent_id +
+                     (gave_up == AcquireStatus::kCancelled ? " cancelled while waiting"
+                                                           : " gave up waiting: deadline exceeded"));
+            waiter.trace.status = gave_up;
+            return waiter.trace;
+        }
+        std::unique_lock<std::mutex> waiter_lock(waiter.mu);
+        waiter.cv.wait(waiter_lock, [&waiter]() { return waiter.decided; });
+    }
+    if (waiter.trace.status == AcquireStatus::kGranted) {
+        print_active_locks();
+    }
+    return waiter.trace;
 }
 
 void ActiveLockTable::release(const std::string& agent_id) {
+    std::vector<LockRef> locks;
     {
-        std::lock_guard<std::mutex> lock(mu_);
-        auto it = std::remove_if(active_.begin(), active_.end(),
-                                 [&](const SemanticLock& entry) {
-                                     return entry.agent_id == agent_id;
-                                 });
-        active_.erase(it, active_.end());
+        std::lock_guard<std::mutex> agents_lock(agents_mu_);
+        auto it = locks_by_agent_.find(agent_id);
+        if (it != locks_by_agent_.end()) {
+            locks = std::move(it->second.refs);
+            forget_agent(it);
+        }
     }
 
-    cv_.notify_all();
+    release_locks(locks);
     print_active_locks();
 }
 
+void ActiveLockTable::release(const std::string& agent_id,
+                              const std::vector<uint64_t>& lock_ids) {
+    std::vector<LockRef> locks;
+    {
+        std::lock_guard<std::mutex> agents_lock(agents_mu_);
+        auto it = locks_by_agent_.find(agent_id);
+        if (it == locks_by_agent_.end()) {
+            return;
+        }
+        std::vector<LockRef>& refs = it->second.refs;
+        const auto named = std::partition(refs.begin(), refs.end(), [&lock_ids](const LockRef& ref) {
+            return std::find(lock_ids.begin(), lock_ids.end(), ref.lock_id) == lock_ids.end();
+        });
+        locks.assign(named, refs.end());
+        refs.erase(named, refs.end());
+        const uint64_t lease = it->second.lease;
+        if (refs.empty()) {
+            forget_agent(it);
+        } else if (lease != 0 && std::none_of(refs.begin(), refs.end(), [lease](const LockRef& ref) {
+                       return ref.lease == lease;
+                   })) {
+            // The lease ends with the last lock it covers.
+            std::lock_guard<std::mutex> lease_lock(lease_mu_);
+            leases_.erase(lease);
+            it->second.lease = 0;
+        }
+    }
+
+    release_locks(locks);
+    print_active_locks();
+}
+
+void ActiveLockTable::forget_agent(std::unordered_map<std::string, AgentLocks>::iterator it) {
+    if (it->second.lease != 0) {
+        // Its timer finds no lease when it fires and is dropped.
+        std::lock_guard<std::mutex> lease_lock(lease_mu_);
+        leases_.erase(it->second.lease);
+    }
+    locks_by_agent_.erase(it);
+}
+
+bool ActiveLockTable::lease_locks(const std::string& agent_id,
+                                  const std::vector<uint64_t>& lock_ids,
+                                  Clock::duration ttl) {
+    const Clock::time_point expires = Clock::now() + ttl;
+    std::lock_guard<std::mutex> agents_lock(agents_mu_);
+    auto it = locks_by_agent_.find(agent_id);
+    if (it == locks_by_agent_.end()) {
+        return false;
+    }
+    AgentLocks& agent = it->second;
+    const auto named = [&lock_ids](const LockRef& ref) {
+        return std::find(lock_ids.begin(), lock_ids.end(), ref.lock_id) != lock_ids.end();
+    };
+    if (std::none_of(agent.refs.begin(), agent.refs.end(), named)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lease_lock(lease_mu_);
+    auto lease_it = leases_.find(agent.lease);
+    if (lease_it == leases_.end()) {
+        // None yet, or the last one ran out; the reaper releases the locks
+        // of that one by its own id.
+        agent.lease = next_lease_++;
+        lease_it = leases_.emplace(agent.lease, Lease{agent_id, expires,
+                                                      std::numeric_limits<uint64_t>::max()})
+                       .first;
+    }
+    for (LockRef& ref : agent.refs) {
+        if (named(ref)) {
+            ref.lease = agent.lease;
+        }
+    }
+    arm_lease(lease_it->first, lease_it->second, expires);
+    return true;
+}
+
+bool ActiveLockTable::renew_lease(const std::string& agent_id, Clock::duration ttl) {
+    const Clock::time_point expires = Clock::now() + ttl;
+    std::lock_guard<std::mutex> agents_lock(agents_mu_);
+    auto it = locks_by_agent_.find(agent_id);
+    if (it == locks_by_agent_.end()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lease_lock(lease_mu_);
+    auto lease_it = leases_.find(it->second.lease);
+    if (lease_it == leases_.end()) {
+        // None, or it already ran out and the reaper is about to release
+        // its locks.
+        return false;
+    }
+    arm_lease(lease_it->first, lease_it->second, expires);
+    return true;
+}
+
+void ActiveLockTable::arm_lease(uint64_t id, Lease& lease, Clock::time_point expires) {
+    lease.expires = expires;
+    const uint64_t due = lease_tick_at(expires) + 1;
+    if (due >= lease.scheduled) {
+        return;
+    }
+    if (lease_wheel_.empty()) {
+        // Skip the idle ticks so the new timer is placed from now.
+        std::vector<uint64_t> none;
+        lease_wheel_.advance(lease_tick_at(Clock::now()), none);
+    }
+    lease.scheduled = due;
+    lease_wheel_.schedule(id, due);
+    if (!reaper_.joinable()) {
+        reaper_ = std::thread([this]() { reap_leases(); });
+    }
+    reaper_cv_.notify_one();
+}
+
 size_t ActiveLockTable::size() const {
-    std::lock_guard<std::mutex> lock(mu_);
-    return active_.size();
+    return active_count_.load();
+}
+
+PivotPruningStats ActiveLockTable::pivot_pruning_stats() const {
+    PivotPruningStats stats;
+    stats.rows_considered = pivot_rows_considered_.load(std::memory_order_relaxed);
+    stats.rows_pruned = pivot_rows_pruned_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ClusterScanStats ActiveLockTable::cluster_scan_stats() const {
+    ClusterScanStats stats;
+    stats.caps_checked = cluster_caps_checked_.load(std::memory_order_relaxed);
+    stats.rows_skipped = cluster_rows_skipped_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void ActiveLockTable::print_active_locks() const {
     std::vector<std::string> agent_ids;
     {
-        std::lock_guard<std::mutex> lock(mu_);
-        agent_ids.reserve(active_.size());
-        for (const auto& entry : active_) {
-            agent_ids.push_back(entry.agent_id);
+        std::shared_lock<std::shared_mutex> layout(layout_mu_);
+        for (const auto& shard : shards_) {
+            const std::shared_ptr<const ShardSnapshot> snapshot = load_snapshot(*shard);
+            if (snapshot == nullptr) {
+                continue;
+            }
+            for (const auto& block : snapshot->blocks) {
+                agent_ids.insert(agent_ids.end(), block->agent_ids.begin(), block->agent_ids.end());
+            }
         }
     }
 
@@ -85,41 +494,1122 @@ void ActiveLockTable::print_active_locks() const {
     log_line(oss.str());
 }
 
-AcquireTrace ActiveLockTable::overlap_trace(const std::vector<float>& embedding,
-                                            float threshold) {
-    AcquireTrace trace;
-    for (const auto& entry : active_) {
-        const float similarity = cosine_similarity(embedding, entry.centroid);
-        if (similarity >= threshold &&
-            similarity >= trace.blocking_similarity_score) {
-            trace.waited = true;
-            trace.blocking_similarity_score = similarity;
-            trace.blocking_agent_id = entry.agent_id;
+void ActiveLockTable::check_row(const LockBlock& block,
+                                size_t slot,
+                                size_t shard_index,
+                                const ScanQuery& query,
+                                size_t query_index,
+                                std::vector<BlockingHit>& hits) const {
+    if (query.mode == LockMode::kShared && block.modes[slot] == LockMode::kShared) {
+        return;
+    }
+    if (!block.clusters.empty() && block.clusters[slot] != nullptr &&
+        cluster_out_of_reach(*block.clusters[slot], query)) {
+        ++query.rows_cluster_skipped;
+        return;
+    }
+    if (!query.pivot_angles.empty()) {
+        ++query.rows_considered;
+        const float* angles = block.pivot_angles.data() + slot * options_.pivot_count;
+        for (size_t j = 0; j < query.pivot_angles.size(); ++j) {
+            // A NaN angle (pivot newer than the row) never compares greater.
+            if (std::fabs(query.pivot_angles[j] - angles[j]) > query.pivot_radius) {
+                ++query.rows_pruned;
+                return;
+            }
+        }
+    }
+    // Clear misses are settled on the int8 copy; only rows whose bound
+    // reaches the band around theta pay for the float row.
+    if (options_.quantized_prefilter &&
+        block.quantized.similarity_upper_bound(query.quantized, slot) <
+            query.threshold - options_.quantized_band) {
+        return;
+    }
+    // Both sides are unit length, so the dot product is the cosine.
+    float similarity = 0.0f;
+    if (options_.half_precision_centroids) {
+        similarity = block.halves.dot(query.embedding->data(), slot);
+        if (similarity < query.threshold - options_.half_precision_band) {
+            return;
+        }
+        // Only a row this close to theta could fall the other way in fp32.
+        if (similarity < query.threshold + options_.half_precision_band) {
+            similarity = dot_(query.embedding->data(), block.centroids.row(slot), dimension_);
+        }
+    } else {
+        similarity = dot_(query.embedding->data(), block.centroids.row(slot), dimension_);
+    }
+    if (similarity >= query.threshold) {
+        hits.push_back(BlockingHit{LockRef{block.lock_ids[slot], shard_index},
+                                   similarity,
+                                   &block.agent_ids[slot],
+                                   query_index});
+    }
+}
+
+bool ActiveLockTable::scan_snapshot(const ShardSnapshot& snapshot,
+                                    size_t shard_index,
+                                    const std::vector<ScanQuery>& queries,
+                                    std::vector<BlockingHit>& hits) const {
+    const bool first_conflict_only = queries.front().first_conflict_only;
+    const size_t before = hits.size();
+    for (const auto& block : snapshot.blocks) {
+        const size_t rows = block->lock_ids.size();
+        for (size_t slot = 0; slot < rows; ++slot) {
+            for (size_t q = 0; q < queries.size(); ++q) {
+                check_row(*block, slot, shard_index, queries[q], q, hits);
+            }
+            if (first_conflict_only && hits.size() != before) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ActiveLockTable::scan_snapshot_parallel(const ShardSnapshot& snapshot,
+                                             size_t shard_index,
+                                             const std::vector<ScanQuery>& queries,
+                                             std::vector<BlockingHit>& hits) const {
+    // A few partitions per thread even out the uneven cost of pruned rows.
+    const size_t blocks = snapshot.blocks.size();
+    const size_t parts = std::min(blocks, (scan_pool_->thread_count() + 1) * kPartitionsPerThread);
+    const bool first_conflict_only = queries.front().first_conflict_only;
+    std::vector<std::vector<BlockingHit>> part_hits(parts);
+    std::vector<std::vector<ScanQuery>> part_queries(parts, queries);
+    for (std::vector<ScanQuery>& part_query : part_queries) {
+        for (ScanQuery& query : part_query) {
+            query.rows_considered = 0;
+            query.rows_pruned = 0;
+            query.caps_checked = 0;
+            query.rows_cluster_skipped = 0;
+            query.cluster_verdicts.clear();
+        }
+    }
+    std::atomic<bool> stop{false};
+    scan_pool_->run(parts, [&](size_t part) {
+        const std::vector<ScanQuery>& part_query = part_queries[part];
+        std::vector<BlockingHit>& found = part_hits[part];
+        const size_t end = (part + 1) * blocks / parts;
+        for (size_t b = part * blocks / parts; b < end; ++b) {
+            // Checked once per block, which bounds the wasted work after
+            // another partition has found a conflict.
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const LockBlock& block = *snapshot.blocks[b];
+            for (size_t slot = 0; slot < block.lock_ids.size(); ++slot) {
+                for (size_t q = 0; q < part_query.size(); ++q) {
+                    check_row(block, slot, shard_index, part_query[q], q, found);
+                }
+            }
+            if (first_conflict_only && !found.empty()) {
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (size_t part = 0; part < parts; ++part) {
+        hits.insert(hits.end(), part_hits[part].begin(), part_hits[part].end());
+        for (size_t q = 0; q < queries.size(); ++q) {
+            queries[q].rows_considered += part_queries[part][q].rows_considered;
+            queries[q].rows_pruned += part_queries[part][q].rows_pruned;
+            queries[q].caps_checked += part_queries[part][q].caps_checked;
+            queries[q].rows_cluster_skipped += part_queries[part][q].rows_cluster_skipped;
+        }
+    }
+    return !stop.load();
+}
+
+void ActiveLockTable::scan_shard(Shard& shard,
+                                 size_t shard_index,
+                                 const std::vector<ScanQuery>& queries,
+                                 uint64_t since_epoch,
+                                 std::vector<BlockingHit>& hits) {
+    // Return false once a first-conflict-only scan has its conflict.
+    const bool first_conflict_only = queries.front().first_conflict_only;
+    const size_t before = hits.size();
+    const auto check = [&](size_t row, size_t q) {
+        check_row(*shard.blocks[row / kBlockRows], row % kBlockRows, shard_index, queries[q], q,
+                  hits);
+        return !first_conflict_only || hits.size() == before;
+    };
+    const auto check_all = [&](size_t row) {
+        for (size_t q = 0; q < queries.size(); ++q) {
+            if (!check(row, q)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (since_epoch == 0 && use_index(shard, shard.rows)) {
+        // The index only proposes candidates; check_row is the exact check.
+        for (size_t q = 0; q < queries.size(); ++q) {
+            shard.candidate_ids.clear();
+            shard.index->candidates(queries[q].embedding->data(), queries[q].threshold,
+                                    shard.candidate_ids);
+            for (const uint64_t lock_id : shard.candidate_ids) {
+                auto it = shard.row_of_lock.find(lock_id);
+                if (it != shard.row_of_lock.end() && !check(it->second, q)) {
+                    return;
+                }
+            }
+        }
+    } else if (since_epoch == 0) {
+        for (size_t row = 0; row < shard.rows; ++row) {
+            if (!check_all(row)) {
+                return;
+            }
+        }
+    } else {
+        for (auto it = shard.row_of_lock.lower_bound(since_epoch);
+             it != shard.row_of_lock.end(); ++it) {
+            if (!check_all(it->second)) {
+                return;
+            }
+        }
+    }
+}
+
+float ActiveLockTable::counting_floor(float threshold) const {
+    float floor = threshold;
+    for (const ConcurrencyBand& band : options_.concurrency_bands) {
+        floor = std::min(floor, band.min_similarity);
+    }
+    return floor;
+}
+
+bool ActiveLockTable::keep_blocking_hits(std::vector<BlockingHit>& hits, float threshold) const {
+    bool dropped = false;
+    // Without bands every hit is at or above the threshold.
+    if (!options_.concurrency_bands.empty() && !hits.empty()) {
+        // Each embedding counts its own bands; within one, a band holding n
+        // locks against a limit of m needs n - m + 1 of them gone, and its
+        // closest holders come first.
+        std::sort(hits.begin(), hits.end(), [](const BlockingHit& a, const BlockingHit& b) {
+            return a.query != b.query ? a.query < b.query : a.similarity > b.similarity;
+        });
+        size_t kept = 0;
+        for (size_t begin = 0; begin < hits.size();) {
+            size_t end = begin;
+            while (end < hits.size() && hits[end].query == hits[begin].query) {
+                ++end;
+            }
+            const auto count_above = [&](float bound) {
+                return static_cast<size_t>(
+                    std::partition_point(hits.begin() + begin, hits.begin() + end,
+                                         [bound](const BlockingHit& hit) {
+                                             return hit.similarity >= bound;
+                                         }) -
+                    (hits.begin() + begin));
+            };
+            size_t keep = count_above(threshold);
+            for (const ConcurrencyBand& band : options_.concurrency_bands) {
+                const size_t holders = count_above(band.min_similarity);
+                if (holders >= band.max_holders) {
+                    keep = std::max(keep, holders - band.max_holders + 1);
+                }
+            }
+            std::move(hits.begin() + begin, hits.begin() + begin + keep, hits.begin() + kept);
+            kept += keep;
+            dropped = dropped || keep < end - begin;
+            begin = end;
+        }
+        hits.resize(kept);
+    }
+    // A lock close to several embeddings is waited on once, at its
+    // highest similarity.
+    if (std::any_of(hits.begin(), hits.end(), [](const BlockingHit& hit) { return hit.query > 0; })) {
+        std::sort(hits.begin(), hits.end(), [](const BlockingHit& a, const BlockingHit& b) {
+            return a.ref.lock_id != b.ref.lock_id ? a.ref.lock_id < b.ref.lock_id
+                                                  : a.similarity > b.similarity;
+        });
+        hits.erase(std::unique(hits.begin(), hits.end(),
+                               [](const BlockingHit& a, const BlockingHit& b) {
+                                   return a.ref.lock_id == b.ref.lock_id;
+                               }),
+                   hits.end());
+    }
+    return dropped;
+}
+
+void ActiveLockTable::prepare_queries(const Waiter& waiter,
+                                      bool first_conflict_only,
+                                      std::vector<ScanQuery>& queries) const {
+    queries.assign(waiter.embeddings.size(), ScanQuery());
+    for (size_t q = 0; q < queries.size(); ++q) {
+        ScanQuery& query = queries[q];
+        query.embedding = waiter.embeddings[q];
+        query.threshold = waiter.floor;
+        query.mode = waiter.mode;
+        query.first_conflict_only = first_conflict_only;
+        if (options_.quantized_prefilter) {
+            quantize_row(query.embedding->data(), query.embedding->size(), query.quantized);
+        }
+        if (options_.pivot_count > 0) {
+            prepare_pivots(query);
+        }
+    }
+    if (options_.cluster_similarity > 0.0f) {
+        // Members lie within arccos(cluster_similarity) of their center, so
+        // none reaches the threshold once the center is that much further
+        // away than arccos(threshold).
+        const float half_turn = std::acos(-1.0f);
+        const float reach = clamped_angle(waiter.floor) + kPivotSlack +
+                            clamped_angle(options_.cluster_similarity);
+        for (ScanQuery& query : queries) {
+            query.cluster_floor = reach < half_turn ? std::cos(reach) : -2.0f;
+        }
+    }
+}
+
+void ActiveLockTable::record_scan_stats(const std::vector<ScanQuery>& queries) {
+    for (const ScanQuery& query : queries) {
+        if (query.rows_considered > 0) {
+            pivot_rows_considered_.fetch_add(query.rows_considered, std::memory_order_relaxed);
+            pivot_rows_pruned_.fetch_add(query.rows_pruned, std::memory_order_relaxed);
+        }
+        if (query.caps_checked > 0) {
+            cluster_caps_checked_.fetch_add(query.caps_checked, std::memory_order_relaxed);
+            cluster_rows_skipped_.fetch_add(query.rows_cluster_skipped,
+                                            std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ActiveLockTable::cluster_out_of_reach(const LockCluster& cluster,
+                                           const ScanQuery& query) const {
+    auto it = query.cluster_verdicts.find(&cluster);
+    if (it == query.cluster_verdicts.end()) {
+        ++query.caps_checked;
+        const float similarity =
+            dot_(query.embedding->data(), cluster.center.data(), dimension_);
+        it = query.cluster_verdicts.emplace(&cluster, similarity < query.cluster_floor).first;
+    }
+    return it->second;
+}
+
+std::shared_ptr<ActiveLockTable::LockCluster> ActiveLockTable::join_cluster(
+    Shard& shard,
+    uint64_t lock_id,
+    const std::vector<float>& embedding) {
+    std::vector<std::shared_ptr<LockCluster>>& open = shard.open_clusters;
+    // Newest first: a burst on one topic keeps joining the same cluster.
+    for (size_t i = open.size(); i-- > 0;) {
+        LockCluster& cluster = *open[i];
+        if (dot_(embedding.data(), cluster.center.data(), dimension_) <
+            options_.cluster_similarity) {
+            continue;
+        }
+        if (cluster.members == 0) {
+            auto seed = shard.row_of_lock.find(cluster.seed_lock_id);
+            if (seed == shard.row_of_lock.end()) {
+                // The seed was released before a second lock came along.
+                open.erase(open.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            writable_block(shard, seed->second / kBlockRows).clusters[seed->second % kBlockRows] =
+                open[i];
+            cluster.members = 1;
+        }
+        ++cluster.members;
+        return open[i];
+    }
+    auto cluster = std::make_shared<LockCluster>();
+    cluster->center = embedding;
+    cluster->seed_lock_id = lock_id;
+    if (open.size() == kOpenClusters) {
+        open.erase(open.begin());
+    }
+    open.push_back(std::move(cluster));
+    return nullptr;
+}
+
+void ActiveLockTable::leave_cluster(Shard& shard, LockCluster& cluster) {
+    if (--cluster.members > 0) {
+        return;
+    }
+    std::vector<std::shared_ptr<LockCluster>>& open = shard.open_clusters;
+    open.erase(std::remove_if(open.begin(), open.end(),
+                              [&cluster](const std::shared_ptr<LockCluster>& entry) {
+                                  return entry.get() == &cluster;
+                              }),
+               open.end());
+}
+
+void ActiveLockTable::prepare_pivots(ScanQuery& query) const {
+    const size_t ready = pivots_ready_.load(std::memory_order_acquire);
+    query.pivot_angles.resize(ready);
+    pivot_angles_of(query.embedding->data(), ready, query.pivot_angles.data());
+    query.pivot_radius = clamped_angle(query.threshold) + kPivotSlack;
+}
+
+void ActiveLockTable::pivot_angles_of(const float* vector, size_t count, float* out) const {
+    for (size_t j = 0; j < count; ++j) {
+        out[j] = clamped_angle(dot_(vector, pivots_.data() + j * dimension_, dimension_));
+    }
+}
+
+void ActiveLockTable::maybe_add_pivot(const float* centroid) {
+    if (pivots_ready_.load(std::memory_order_acquire) >= options_.pivot_count) {
+        return;
+    }
+    std::lock_guard<std::mutex> pivots_lock(pivots_mu_);
+    const size_t ready = pivots_ready_.load(std::memory_order_relaxed);
+    if (ready >= options_.pivot_count) {
+        return;
+    }
+    for (size_t j = 0; j < ready; ++j) {
+        if (dot_(centroid, pivots_.data() + j * dimension_, dimension_) >=
+            kPivotMaxSimilarity) {
+            return;
+        }
+    }
+    std::copy(centroid, centroid + dimension_, pivots_.begin() + ready * dimension_);
+    pivots_ready_.store(ready + 1, std::memory_order_release);
+}
+
+bool ActiveLockTable::use_index(const Shard& shard, size_t rows) const {
+    return shard.index != nullptr && rows >= options_.index_min_locks;
+}
+
+std::shared_ptr<const ActiveLockTable::ShardSnapshot> ActiveLockTable::load_snapshot(
+    Shard& shard) const {
+    std::lock_guard<std::mutex> snapshot_lock(shard.snapshot_mu);
+    return shard.snapshot;
+}
+
+void ActiveLockTable::publish_snapshot(Shard& shard) {
+    auto snapshot = std::make_shared<ShardSnapshot>();
+    snapshot->blocks.assign(shard.blocks.begin(), shard.blocks.end());
+    snapshot->rows = shard.rows;
+    snapshot->epoch = next_epoch_.load();
+    std::shared_ptr<const ShardSnapshot> retired;
+    {
+        std::lock_guard<std::mutex> snapshot_lock(shard.snapshot_mu);
+        retired = std::move(shard.snapshot);
+        shard.snapshot = std::move(snapshot);
+    }
+    // `retired` is dropped here, outside snapshot_mu.
+}
+
+ActiveLockTable::LockBlock& ActiveLockTable::writable_block(Shard& shard, size_t block_index) {
+    std::shared_ptr<LockBlock>& block = shard.blocks[block_index];
+    // Every block in the last published snapshot is referenced by it, so a
+    // use count of one means the block was created or copied after that
+    // publish and no reader can see it.
+    if (block.use_count() > 1) {
+        block = std::make_shared<LockBlock>(*block);
+    }
+    return *block;
+}
+
+ActiveLockTable::LockRef ActiveLockTable::insert_lock(const std::string& agent_id,
+                                                      const std::vector<float>& embedding,
+                                                      float threshold,
+                                                      LockMode mode) {
+    if (options_.pivot_count > 0) {
+        maybe_add_pivot(embedding.data());
+    }
+    // The home shard is always among the probed shards, so it is locked.
+    const size_t home = sharder_.home_shard(embedding.data());
+    Shard& shard = *shards_[home];
+    const uint64_t lock_id = next_epoch_.fetch_add(1);
+    std::shared_ptr<LockCluster> cluster;
+    if (options_.cluster_similarity > 0.0f) {
+        cluster = join_cluster(shard, lock_id, embedding);
+    }
+    const size_t row =
+        append_row(shard, lock_id, embedding, threshold, mode, std::move(cluster), agent_id);
+    shard.row_of_lock.emplace_hint(shard.row_of_lock.end(), lock_id, row);
+    if (shard.index != nullptr) {
+        shard.index->insert(lock_id, embedding.data());
+    }
+    active_count_.fetch_add(1);
+    const LockRef ref{lock_id, home};
+    {
+        std::lock_guard<std::mutex> agents_lock(agents_mu_);
+        locks_by_agent_[agent_id].refs.push_back(ref);
+    }
+    return ref;
+}
+
+bool ActiveLockTable::tracks_intents() const {
+    return options_.queue_policy != QueuePolicy::kOvertake || options_.writer_preference;
+}
+
+void ActiveLockTable::find_queued_ahead(const Waiter& arrival, std::vector<QueuedHit>& ahead) {
+    // A reader only conflicts with queued writers, and with writer
+    // preference it lets every one of them go first.
+    const bool writers_first =
+        arrival.mode == LockMode::kShared && options_.writer_preference;
+    if (options_.queue_policy == QueuePolicy::kOvertake && !writers_first) {
+        return;
+    }
+    for (const size_t index : arrival.probe) {
+        for (Waiter* queued : shards_[index]->intents) {
+            if (!modes_conflict(arrival.mode, queued->mode)) {
+                continue;
+            }
+            // A waiter with several homes is listed in each; it is only
+            // considered in the first one this arrival probes.
+            if (queued->homes.size() > 1 &&
+                *std::find_if(queued->homes.begin(), queued->homes.end(),
+                              [&arrival](size_t home) {
+                                  return std::binary_search(arrival.probe.begin(),
+                                                            arrival.probe.end(), home);
+                              }) != index) {
+                continue;
+            }
+            float similarity = -1.0f;
+            for (const std::vector<float>* mine : arrival.embeddings) {
+                for (const std::vector<float>* theirs : queued->embeddings) {
+                    similarity =
+                        std::max(similarity, dot_(mine->data(), theirs->data(), dimension_));
+                }
+            }
+            if (similarity < arrival.threshold) {
+                continue;
+            }
+            // A bypass is counted when the arrival is let past, even if an
+            // active lock then holds it up anyway.
+            if (options_.queue_policy == QueuePolicy::kBoundedBypass && !writers_first &&
+                queued->bypassed < options_.max_bypass) {
+                ++queued->bypassed;
+                continue;
+            }
+            ahead.push_back(QueuedHit{queued, similarity});
+        }
+    }
+}
+
+void ActiveLockTable::block_waiter(Waiter& waiter,
+                                   const std::vector<BlockingHit>& hits,
+                                   const std::vector<QueuedHit>& ahead) {
+    if (waiter.trace.waited && !waiter.diagnostics) {
+        // Without diagnostics the blocker is named once per wait, from the
+        // conflict the arrival found; waking up only re-registers.
+        std::ostringstream oss;
+        oss << "[LOCK] " << *waiter.agent_id << " still blocked blockers=" << hits.size();
+        log_line(oss.str());
+    } else {
+        float strongest = -1.0f;
+        const std::string* strongest_agent_id = nullptr;
+        for (const BlockingHit& hit : hits) {
+            if (hit.similarity > strongest) {
+                strongest = hit.similarity;
+                strongest_agent_id = hit.agent_id;
+            }
+        }
+        for (const QueuedHit& queued : ahead) {
+            if (queued.similarity > strongest) {
+                strongest = queued.similarity;
+                strongest_agent_id = queued.waiter->agent_id;
+            }
+        }
+        const float blocking_score = std::min(1.0f, strongest);
+        waiter.trace.waited = true;
+        if (blocking_score >= waiter.trace.blocking_similarity_score) {
+            waiter.trace.blocking_similarity_score = blocking_score;
+            waiter.trace.blocking_agent_id = *strongest_agent_id;
+        }
+
+        std::ostringstream oss;
+        oss << "[LOCK] " << *waiter.agent_id
+            << " blocked by " << *strongest_agent_id
+            << " similarity=" << std::fixed << std::setprecision(3) << blocking_score
+            << " threshold=" << waiter.threshold
+            << " blockers=" << hits.size();
+        if (waiter.mode == LockMode::kShared) {
+            oss << " mode=shared";
+        }
+        if (!ahead.empty()) {
+            oss << " queued_behind=" << ahead.size();
+        }
+        log_line(oss.str());
+    }
+
+    {
+        std::lock_guard<std::mutex> waiter_lock(waiter.mu);
+        waiter.pending_blockers = hits.size() + ahead.size();
+    }
+    for (const BlockingHit& hit : hits) {
+        shards_[hit.ref.shard]->waiters_by_lock[hit.ref.lock_id].push_back(&waiter);
+    }
+    for (const QueuedHit& queued : ahead) {
+        queued.waiter->followers.push_back(&waiter);
+    }
+}
+
+void ActiveLockTable::remove_intent(Waiter& waiter) {
+    for (const size_t home : waiter.homes) {
+        std::vector<Waiter*>& intents = shards_[home]->intents;
+        intents.erase(std::remove(intents.begin(), intents.end(), &waiter), intents.end());
+    }
+}
+
+bool ActiveLockTable::misses_deadline(Clock::time_point deadline, Clock::time_point now) const {
+    return deadline != Clock::time_point::max() && now > deadline - options_.deadline_slack;
+}
+
+void ActiveLockTable::withdraw_waiter(Waiter& waiter, std::vector<Waiter*>& freed) {
+    if (!tracks_intents()) {
+        return;
+    }
+    remove_intent(waiter);
+    for (Waiter* follower : waiter.followers) {
+        std::lock_guard<std::mutex> follower_lock(follower->mu);
+        if (--follower->pending_blockers == 0) {
+            freed.push_back(follower);
+        }
+    }
+    waiter.followers.clear();
+}
+
+bool ActiveLockTable::abandon_waiter(Waiter& waiter) {
+    std::shared_lock<std::shared_mutex> layout(layout_mu_);
+    // A waiter can be registered in any shard, and this is the rare path,
+    // so every shard is locked rather than tracking where it is listed.
+    std::vector<std::unique_lock<std::mutex>> shard_locks;
+    for (auto& shard : shards_) {
+        shard_locks.emplace_back(shard->mu);
+    }
+    {
+        // Counts only drop under a shard mutex, so this cannot change now.
+        // Zero means a release has claimed the waiter and will decide it.
+        std::lock_guard<std::mutex> waiter_lock(waiter.mu);
+        if (waiter.pending_blockers == 0) {
+            return false;
+        }
+        waiter.pending_blockers = 0;
+    }
+    std::vector<Waiter*> freed;
+    for (auto& shard : shards_) {
+        for (auto it = shard->waiters_by_lock.begin(); it != shard->waiters_by_lock.end();) {
+            std::vector<Waiter*>& listed = it->second;
+            listed.erase(std::remove(listed.begin(), listed.end(), &waiter), listed.end());
+            it = listed.empty() ? shard->waiters_by_lock.erase(it) : std::next(it);
+        }
+        for (Waiter* queued : shard->intents) {
+            std::vector<Waiter*>& followers = queued->followers;
+            followers.erase(std::remove(followers.begin(), followers.end(), &waiter),
+                            followers.end());
+        }
+    }
+    withdraw_waiter(waiter, freed);
+    shard_locks.clear();
+    admit_waiters(std::move(freed));
+    return true;
+}
+
+void ActiveLockTable::admit_waiters(std::vector<Waiter*> ready) {
+    // Arrivals freed by a shed waiter may probe shards this round does not
+    // hold, so they are decided in a round of their own.
+    std::vector<Waiter*> freed;
+    while (!ready.empty()) {
+        admit_batch(ready, freed);
+        ready.swap(freed);
+        freed.clear();
+    }
+}
+
+void ActiveLockTable::admit_batch(const std::vector<Waiter*>& ready, std::vector<Waiter*>& freed) {
+    std::vector<size_t> shard_ids;
+    uint64_t since = std::numeric_limits<uint64_t>::max();
+    for (const Waiter* waiter : ready) {
+        shard_ids.insert(shard_ids.end(), waiter->probe.begin(), waiter->probe.end());
+        if (waiter->scanned_epoch != 0) {
+            since = std::min(since, waiter->scanned_epoch);
+        }
+    }
+    std::sort(shard_ids.begin(), shard_ids.end());
+    shard_ids.erase(std::unique(shard_ids.begin(), shard_ids.end()), shard_ids.end());
+    std::vector<std::unique_lock<std::mutex>> shard_locks;
+    for (const size_t index : shard_ids) {
+        shard_locks.emplace_back(shards_[index]->mu);
+    }
+
+    // Columns: every lock some waiter has not checked yet, then the
+    // waiters' embeddings, which are also the rows; waiter i owns rows
+    // [first_row[i], first_row[i + 1]). The blocks are pinned so the grants below copy them
+    // instead of moving rows that `candidates` points into.
+    std::vector<BlockingHit> candidates;
+    std::vector<LockMode> candidate_modes;
+    std::vector<const float*> columns;
+    std::vector<std::shared_ptr<const LockBlock>> pinned;
+    std::vector<bool> pinned_shard(shards_.size(), false);
+    const auto pin = [&](size_t index) {
+        if (!pinned_shard[index]) {
+            pinned_shard[index] = true;
+            pinned.insert(pinned.end(), shards_[index]->blocks.begin(),
+                          shards_[index]->blocks.end());
+        }
+    };
+    // Waiters whose last scan stopped early, or that wait on only part of a
+    // band, have no epoch to check from. Each gets one full scan of its
+    // shards here, which finds every blocker in the table; from then on it
+    // only needs the locks this batch grants, like any other waiter.
+    std::vector<std::vector<BlockingHit>> table_hits(ready.size());
+    const uint64_t scan_epoch = next_epoch_.load();
+    std::vector<ScanQuery> queries;
+    for (size_t i = 0; i < ready.size(); ++i) {
+        Waiter& waiter = *ready[i];
+        if (waiter.scanned_epoch != 0) {
+            continue;
+        }
+        prepare_queries(waiter, false, queries);
+        for (const size_t index : waiter.probe) {
+            pin(index);
+            scan_shard(*shards_[index], index, queries, 0, table_hits[i]);
+        }
+        record_scan_stats(queries);
+        waiter.scanned_epoch = scan_epoch;
+    }
+    for (const size_t index : shard_ids) {
+        Shard& shard = *shards_[index];
+        auto it = shard.row_of_lock.lower_bound(since);
+        if (it == shard.row_of_lock.end()) {
+            continue;
+        }
+        pin(index);
+        for (; it != shard.row_of_lock.end(); ++it) {
+            const LockBlock& block = *shard.blocks[it->second / kBlockRows];
+            const size_t slot = it->second % kBlockRows;
+            candidates.push_back(
+                BlockingHit{LockRef{it->first, index}, 0.0f, &block.agent_ids[slot]});
+            candidate_modes.push_back(block.modes[slot]);
+            columns.push_back(block.centroids.row(slot));
+        }
+    }
+    const size_t existing = candidates.size();
+    std::vector<size_t> first_row(ready.size() + 1, 0);
+    for (size_t i = 0; i < ready.size(); ++i) {
+        for (const std::vector<float>* embedding : ready[i]->embeddings) {
+            columns.push_back(embedding->data());
+        }
+        first_row[i + 1] = first_row[i] + ready[i]->embeddings.size();
+    }
+    const size_t rows = first_row.back();
+    const size_t width = columns.size();
+    std::vector<float> similarity(rows * width);
+    dot_product_matrix(columns.data() + existing, rows, columns.data(), width,
+                       dimension_, similarity.data());
+    for (size_t i = 0; i < ready.size(); ++i) {
+        const float reach = ready[i]->floor - kMatrixSlack;
+        for (size_t r = first_row[i]; r < first_row[i + 1]; ++r) {
+            float* row = similarity.data() + r * width;
+            for (size_t j = 0; j < width; ++j) {
+                if (row[j] >= reach) {
+                    row[j] = dot_(columns[existing + r], columns[j], dimension_);
+                }
+            }
+        }
+    }
+
+    // Greedy independent set over the waiters' conflict graph, earliest
+    // deadline first and oldest among equals: a waiter goes through when the
+    // locks it has not checked yet and the waiters granted before it, in a
+    // conflicting mode, leave it under its threshold and every band.
+    // Whoever is left out conflicts with something granted, so the granted
+    // set is maximal. Waiters that could no longer answer in time are shed
+    // instead of granted.
+    std::vector<size_t> order(ready.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&ready](size_t a, size_t b) {
+        return std::tie(ready[a]->deadline, ready[a]->arrival) <
+               std::tie(ready[b]->deadline, ready[b]->arrival);
+    });
+    const Clock::time_point now = Clock::now();
+    // One lock per row of an admitted waiter.
+    std::vector<LockRef> granted(rows);
+    std::vector<bool> admitted(ready.size(), false);
+    std::vector<bool> shed(ready.size(), false);
+    std::vector<bool> touched(shards_.size(), false);
+    size_t admitted_count = 0;
+    size_t shed_count = 0;
+    // Gathers into `hits` what holds waiter i back: its full-scan hits, the
+    // locks it has not checked yet and the waiters admitted so far. Returns
+    // keep_blocking_hits' answer.
+    std::vector<BlockingHit> hits;
+    const auto collect_hits = [&](size_t i) {
+        const Waiter& waiter = *ready[i];
+        hits.assign(table_hits[i].begin(), table_hits[i].end());
+        for (size_t r = first_row[i]; r < first_row[i + 1]; ++r) {
+            const float* row = similarity.data() + r * width;
+            const size_t query = r - first_row[i];
+            for (size_t j = 0; j < existing; ++j) {
+                if (candidates[j].ref.lock_id >= waiter.scanned_epoch && row[j] >= waiter.floor &&
+                    modes_conflict(waiter.mode, candidate_modes[j])) {
+                    hits.push_back(candidates[j]);
+                    hits.back().similarity = row[j];
+                    hits.back().query = query;
+                }
+            }
+            for (size_t k = 0; k < ready.size(); ++k) {
+                if (!admitted[k] || !modes_conflict(waiter.mode, ready[k]->mode)) {
+                    continue;
+                }
+                for (size_t c = first_row[k]; c < first_row[k + 1]; ++c) {
+                    if (row[existing + c] >= waiter.floor) {
+                        hits.push_back(BlockingHit{granted[c], row[existing + c],
+                                                   ready[k]->agent_id, query});
+                    }
+                }
+            }
+        }
+        return keep_blocking_hits(hits, waiter.threshold);
+    };
+    for (const size_t i : order) {
+        Waiter& waiter = *ready[i];
+        if (misses_deadline(waiter.deadline, now)) {
+            waiter.trace.status = AcquireStatus::kDeadlineExceeded;
+            withdraw_waiter(waiter, freed);
+            shed[i] = true;
+            ++shed_count;
+            log_line("[LOCK] " + *waiter.agent_id + " shed: deadline cannot be met");
+            continue;
+        }
+        collect_hits(i);
+        if (hits.empty()) {
+            for (size_t r = first_row[i]; r < first_row[i + 1]; ++r) {
+                granted[r] = insert_lock(*waiter.agent_id, *waiter.embeddings[r - first_row[i]],
+                                         waiter.threshold, waiter.mode);
+                waiter.trace.lock_ids.push_back(granted[r].lock_id);
+                touched[granted[r].shard] = true;
+            }
+            admitted[i] = true;
+            ++admitted_count;
+            if (tracks_intents()) {
+                // Followers conflict with this waiter, so from now on they
+                // wait on its first lock, which lives in a home shard; its
+                // locks are all released together.
+                remove_intent(waiter);
+                const LockRef& first = granted[first_row[i]];
+                std::vector<Waiter*>& moved = shards_[first.shard]->waiters_by_lock[first.lock_id];
+                moved.insert(moved.end(), waiter.followers.begin(), waiter.followers.end());
+                waiter.followers.clear();
+            }
+        }
+    }
+    if (ready.size() > 1) {
+        std::ostringstream oss;
+        oss << "[LOCK] release admitted " << admitted_count << " of "
+            << ready.size() << " ready waiters";
+        if (shed_count > 0) {
+            oss << " (shed " << shed_count << ")";
+        }
+        log_line(oss.str());
+    }
+
+    // The rest wait again, on every conflicting lock including the ones just
+    // granted. Nothing else can insert into these shards while they are held.
+    const uint64_t epoch = next_epoch_.load();
+    for (size_t i = 0; i < ready.size(); ++i) {
+        if (admitted[i] || shed[i]) {
+            continue;
+        }
+        Waiter& waiter = *ready[i];
+        const bool recount = collect_hits(i);
+        waiter.scanned_epoch = recount ? 0 : epoch;
+        block_waiter(waiter, hits, {});
+    }
+
+    for (const size_t index : shard_ids) {
+        if (touched[index]) {
+            publish_snapshot(*shards_[index]);
+        }
+    }
+    // Hand the granted and shed waiters back last: each destroys its Waiter
+    // as soon as it can take the waiter mutex, and the hits above still used
+    // them.
+    for (size_t i = 0; i < ready.size(); ++i) {
+        if (admitted[i] || shed[i]) {
+            std::lock_guard<std::mutex> waiter_lock(ready[i]->mu);
+            ready[i]->decided = true;
+            ready[i]->cv.notify_one();
+        }
+    }
+}
+
+size_t ActiveLockTable::append_row(Shard& shard,
+                                   uint64_t lock_id,
+                                   const std::vector<float>& embedding,
+                                   float threshold,
+                                   LockMode mode,
+                                   std::shared_ptr<LockCluster> cluster,
+                                   const std::string& agent_id) {
+    const size_t row = shard.rows;
+    if (row % kBlockRows == 0) {
+        auto block = std::make_shared<LockBlock>();
+        block->centroids.reset(dimension_);
+        block->quantized.reset(dimension_);
+        block->halves.reset(dimension_);
+        shard.blocks.push_back(std::move(block));
+    }
+    LockBlock& block = writable_block(shard, row / kBlockRows);
+    block.centroids.push_back(embedding.data());
+    if (options_.quantized_prefilter) {
+        block.quantized.push_back(embedding.data());
+    }
+    if (options_.half_precision_centroids) {
+        block.halves.push_back(embedding.data());
+    }
+    if (options_.pivot_count > 0) {
+        const size_t offset = block.pivot_angles.size();
+        block.pivot_angles.resize(offset + options_.pivot_count,
+                                  std::numeric_limits<float>::quiet_NaN());
+        pivot_angles_of(embedding.data(), pivots_ready_.load(std::memory_order_acquire),
+                        block.pivot_angles.data() + offset);
+    }
+    if (options_.cluster_similarity > 0.0f) {
+        block.clusters.push_back(std::move(cluster));
+    }
+    block.thresholds.push_back(threshold);
+    block.modes.push_back(mode);
+    block.agent_ids.push_back(agent_id);
+    block.lock_ids.push_back(lock_id);
+    ++shard.rows;
+    return row;
+}
+
+void ActiveLockTable::adopt_dimension(size_t dimension) {
+    std::unique_lock<std::shared_mutex> layout(layout_mu_);
+    // Another acquire may have fixed the dimension first.
+    if (dimension_ != 0) {
+        return;
+    }
+    dimension_ = dimension;
+    dot_ = dot_kernel_for_dimension(dimension);
+    const bool trained = options_.shard_bits > 0 && !options_.shard_centroids.empty() &&
+                         options_.shard_centroid_dimension == dimension;
+    if (trained) {
+        sharder_ = SimHashSharder(dimension, options_.shard_bits, options_.shard_centroids);
+    } else {
+        sharder_ = SimHashSharder(dimension, options_.shard_bits, kShardSeed);
+        if (options_.shard_bits > 0 && !options_.shard_centroids.empty()) {
+            std::ostringstream oss;
+            oss << "[LOCK] shard centroids have dimension " << options_.shard_centroid_dimension
+                << " but embeddings have " << dimension << "; placing by SimHash";
+            log_line(oss.str());
+        }
+    }
+    pivots_.assign(options_.pivot_count * dimension, 0.0f);
+    pivots_ready_.store(0);
+    for (auto& shard : shards_) {
+        reset_shard(*shard, dimension);
+    }
+    if (shards_.size() > 1) {
+        std::ostringstream oss;
+        oss << "[LOCK] dimension " << dimension << " split across " << shards_.size();
+        if (trained) {
+            oss << " shards by " << sharder_.cell_count() << " trained centroids";
+        } else {
+            oss << " SimHash shards";
+        }
+        log_line(oss.str());
+    }
+}
+
+void ActiveLockTable::reset_shard(Shard& shard, size_t dimension) {
+    shard.blocks.clear();
+    shard.rows = 0;
+    shard.row_of_lock.clear();
+    shard.open_clusters.clear();
+    shard.index.reset();
+    if (options_.index_kind == ConflictIndexKind::kHnsw) {
+        shard.index = std::make_unique<HnswIndex>(dimension, options_.hnsw);
+    } else if (options_.index_kind == ConflictIndexKind::kIvf) {
+        if (options_.ivf_dimension == dimension) {
+            shard.index = std::make_unique<IvfIndex>(dimension, options_.ivf_centroids);
+        } else if (&shard == shards_.front().get()) {
+            std::ostringstream oss;
+            oss << "[LOCK] IVF centroids have dimension " << options_.ivf_dimension
+                << " but embeddings have " << dimension << "; scanning linearly";
+            log_line(oss.str());
         }
     }
-    return trace;
+    publish_snapshot(shard);
 }
 
-float ActiveLockTable::cosine_similarity(const std::vector<float>& a,
-                                         const std::vector<float>& b) {
-    if (a.empty() || b.empty() || a.size() != b.size()) {
-        return 0.0f;
+void ActiveLockTable::remove_row(Shard& shard, size_t row) {
+    const bool clustered = options_.cluster_similarity > 0.0f;
+    if (clustered) {
+        const std::shared_ptr<LockCluster>& cluster =
+            shard.blocks[row / kBlockRows]->clusters[row % kBlockRows];
+        if (cluster != nullptr) {
+            leave_cluster(shard, *cluster);
+        }
+    }
+    const size_t last = shard.rows - 1;
+    LockBlock& tail = writable_block(shard, last / kBlockRows);
+    const size_t tail_slot = last % kBlockRows;
+    if (row != last) {
+        // Move the last row into the hole, as CentroidMatrix::swap_remove
+        // does within one block.
+        LockBlock& dest = writable_block(shard, row / kBlockRows);
+        const size_t slot = row % kBlockRows;
+        dest.centroids.set_row(slot, tail.centroids.row(tail_slot));
+        if (options_.quantized_prefilter) {
+            dest.quantized.copy_row(slot, tail.quantized, tail_slot);
+        }
+        if (options_.half_precision_centroids) {
+            dest.halves.copy_row(slot, tail.halves, tail_slot);
+        }
+        dest.thresholds[slot] = tail.thresholds[tail_slot];
+        dest.modes[slot] = tail.modes[tail_slot];
+        std::copy_n(tail.pivot_angles.begin() + tail_slot * options_.pivot_count,
+                    options_.pivot_count,
+                    dest.pivot_angles.begin() + slot * options_.pivot_count);
+        if (clustered) {
+            dest.clusters[slot] = std::move(tail.clusters[tail_slot]);
+        }
+        dest.agent_ids[slot] = std::move(tail.agent_ids[tail_slot]);
+        dest.lock_ids[slot] = tail.lock_ids[tail_slot];
+        shard.row_of_lock[dest.lock_ids[slot]] = row;
+    }
+    tail.centroids.swap_remove(tail_slot);
+    if (options_.quantized_prefilter) {
+        tail.quantized.swap_remove(tail_slot);
     }
+    if (options_.half_precision_centroids) {
+        tail.halves.swap_remove(tail_slot);
+    }
+    tail.thresholds.pop_back();
+    tail.modes.pop_back();
+    tail.pivot_angles.resize(tail.pivot_angles.size() - options_.pivot_count);
+    if (clustered) {
+        tail.clusters.pop_back();
+    }
+    tail.agent_ids.pop_back();
+    tail.lock_ids.pop_back();
+    if (tail.lock_ids.empty()) {
+        shard.blocks.pop_back();
+    }
+    --shard.rows;
+}
 
-    double dot = 0.0;
-    double norm_a = 0.0;
-    double norm_b = 0.0;
-    for (size_t i = 0; i < a.size(); ++i) {
-        dot += static_cast<double>(a[i]) * static_cast<double>(b[i]);
-        norm_a += static_cast<double>(a[i]) * static_cast<double>(a[i]);
-        norm_b += static_cast<double>(b[i]) * static_cast<double>(b[i]);
+void ActiveLockTable::release_locks(const std::vector<LockRef>& locks) {
+    if (locks.empty()) {
+        return;
+    }
+    std::shared_lock<std::shared_mutex> layout(layout_mu_);
+    std::vector<Waiter*> ready;
+    for (const LockRef& ref : locks) {
+        Shard& shard = *shards_[ref.shard];
+        std::lock_guard<std::mutex> shard_lock(shard.mu);
+        remove_lock(shard, ref.lock_id, ready);
+        publish_snapshot(shard);
     }
+    admit_waiters(ready);
+}
 
-    if (norm_a <= 0.0 || norm_b <= 0.0) {
-        return 0.0f;
+uint64_t ActiveLockTable::lease_tick_at(Clock::time_point time) const {
+    if (time <= lease_origin_) {
+        return 0;
     }
+    return static_cast<uint64_t>((time - lease_origin_) / options_.lease_tick);
+}
 
-    const double similarity = dot / (std::sqrt(norm_a) * std::sqrt(norm_b));
-    const double clamped = std::max(-1.0, std::min(1.0, similarity));
-    return static_cast<float>(clamped);
+void ActiveLockTable::reap_leases() {
+    std::vector<uint64_t> fired;
+    std::vector<std::pair<std::string, uint64_t>> expired;
+    std::unique_lock<std::mutex> lease_lock(lease_mu_);
+    while (!reaper_stopping_) {
+        if (lease_wheel_.empty()) {
+            reaper_cv_.wait(lease_lock);
+            continue;
+        }
+        // Sleeps through the ticks in which no timer can fire; a renewal
+        // that arms an earlier timer wakes it.
+        const auto next_tick = static_cast<int64_t>(lease_wheel_.next_tick());
+        reaper_cv_.wait_until(lease_lock, lease_origin_ + options_.lease_tick * next_tick);
+        const Clock::time_point now = Clock::now();
+        fired.clear();
+        lease_wheel_.advance(lease_tick_at(now), fired);
+        for (const uint64_t id : fired) {
+            auto it = leases_.find(id);
+            // Released, or a timer left behind by a renewal that shortened
+            // the lease.
+            if (it == leases_.end() || it->second.scheduled > lease_wheel_.current_tick()) {
+                continue;
+            }
+            if (it->second.expires > now) {
+                it->second.scheduled = lease_tick_at(it->second.expires) + 1;
+                lease_wheel_.schedule(id, it->second.scheduled);
+                continue;
+            }
+            expired.emplace_back(std::move(it->second.agent_id), id);
+            leases_.erase(it);
+        }
+        if (expired.empty()) {
+            continue;
+        }
+        lease_lock.unlock();
+        for (const auto& [agent_id, lease] : expired) {
+            expire_lease(agent_id, lease);
+        }
+        expired.clear();
+        lease_lock.lock();
+    }
+}
+
+void ActiveLockTable::expire_lease(const std::string& agent_id, uint64_t lease) {
+    std::vector<LockRef> locks;
+    {
+        std::lock_guard<std::mutex> agents_lock(agents_mu_);
+        auto it = locks_by_agent_.find(agent_id);
+        if (it == locks_by_agent_.end()) {
+            return;
+        }
+        // Locks the agent took since without a lease, or under a newer one,
+        // stay with it.
+        std::vector<LockRef>& refs = it->second.refs;
+        const auto leased = std::partition(refs.begin(), refs.end(), [lease](const LockRef& ref) {
+            return ref.lease != lease;
+        });
+        locks.assign(leased, refs.end());
+        refs.erase(leased, refs.end());
+        if (it->second.lease == lease) {
+            it->second.lease = 0;
+        }
+        if (refs.empty()) {
+            forget_agent(it);
+        }
+    }
+    if (locks.empty()) {
+        return;
+    }
+    log_line("[LOCK] lease of " + agent_id + " ran out; releasing " +
+             std::to_string(locks.size()) + " lock(s)");
+    release_locks(locks);
+    print_active_locks();
+}
+
+void ActiveLockTable::remove_lock(Shard& shard, uint64_t lock_id, std::vector<Waiter*>& ready) {
+    auto row_it = shard.row_of_lock.find(lock_id);
+    if (row_it == shard.row_of_lock.end()) {
+        return;
+    }
+    const size_t row = row_it->second;
+    shard.row_of_lock.erase(row_it);
+    remove_row(shard, row);
+    if (shard.index != nullptr) {
+        shard.index->remove(lock_id);
+    }
+    active_count_.fetch_sub(1);
+
+    auto waiters_it = shard.waiters_by_lock.find(lock_id);
+    if (waiters_it == shard.waiters_by_lock.end()) {
+        return;
+    }
+    for (Waiter* waiter : waiters_it->second) {
+        std::lock_guard<std::mutex> waiter_lock(waiter->mu);
+        if (--waiter->pending_blockers == 0) {
+            ready.push_back(waiter);
+        }
+    }
+    shard.waiters_by_lock.erase(waiters_it);
 }
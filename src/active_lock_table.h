@@ -4,44 +4,683 @@
 
 #pragma once
 
+#include "centroid_matrix.h"
+#include "conflict_index.h"
+#include "half_matrix.h"
+#include "hnsw_index.h"
+#include "ivf_index.h"
+#include "quantized_matrix.h"
+#include "scan_pool.h"
+#include "simhash_sharder.h"
+#include "similarity_kernels.h"
+#include "timer_wheel.h"
+
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-struct SemanticLock {
-    std::string agent_id;
-    std::vector<float> centroid;
-    float threshold;
+enum class ConflictIndexKind {
+    kLinear,
+    kHnsw,
+    kIvf,
+};
+
+// How a new acquire treats earlier acquires that are still waiting.
+enum class QueuePolicy {
+    // Only active locks block an arrival, so a steady stream of arrivals can
+    // keep overtaking a waiter.
+    kOvertake,
+    // An arrival queues behind every older waiter it conflicts with.
+    kFifo,
+    // Arrivals may overtake a conflicting waiter until it has been bypassed
+    // max_bypass times; after that they queue behind it as with kFifo.
+    kBoundedBypass,
+};
+
+// Shared locks only conflict with exclusive ones; exclusive locks conflict
+// with every lock above the threshold.
+enum class LockMode : uint8_t {
+    kExclusive,
+    kShared,
+};
+
+// Lets up to max_holders conflicting locks sit at or above min_similarity
+// from a request before it has to wait.
+struct ConcurrencyBand {
+    float min_similarity = 0.0f;
+    size_t max_holders = 1;
+};
+
+struct ActiveLockTableOptions {
+    ConflictIndexKind index_kind = ConflictIndexKind::kLinear;
+    // Below this many active locks in a shard a full scan is cheaper than the
+    // index, so the shard is scanned linearly even when an index is configured.
+    size_t index_min_locks = 512;
+    HnswParams hnsw;
+    // Bucket-major coarse centroids written by dscc-ivf-train. The IVF index
+    // is only built when ivf_dimension matches the embeddings in use.
+    std::vector<float> ivf_centroids;
+    size_t ivf_dimension = 0;
+    // Keeps an int8 copy of every centroid and rejects rows whose quantized
+    // similarity bound stays below theta - quantized_band without reading
+    // the float row. The bound already covers quantization error, so the
+    // band only needs to absorb float rounding.
+    bool quantized_prefilter = false;
+    float quantized_band = 1e-3f;
+    // Keeps an fp16 copy of every centroid and scans it in place of the fp32
+    // rows, which halves the bytes a scan streams. Only rows whose fp16
+    // similarity lands within half_precision_band of theta read the fp32 row.
+    // A band of at least HalfMatrix::kUnitRoundingBound leaves every decision
+    // as it would be in fp32.
+    bool half_precision_centroids = false;
+    float half_precision_band = 1e-3f;
+    // Splits the table into 2^shard_bits SimHash shards, each with its own
+    // mutex, storage, index and waiter lists. 0 keeps a single shard.
+    size_t shard_bits = 0;
+    // Bucket-major centroids written by dscc-ivf-train. When
+    // shard_centroid_dimension matches the embeddings in use, locks are
+    // placed by nearest centroid instead of by random SimHash planes.
+    std::vector<float> shard_centroids;
+    size_t shard_centroid_dimension = 0;
+    QueuePolicy queue_policy = QueuePolicy::kOvertake;
+    size_t max_bypass = 8;
+    // A shared acquire queues behind every older exclusive waiter it
+    // conflicts with, whatever the queue policy, so a steady stream of
+    // readers cannot starve a writer. Exclusive acquires follow queue_policy.
+    bool writer_preference = true;
+    // Graded limits below each request's threshold, which itself acts as a
+    // band of one holder. A request waits while any band already holds
+    // max_holders conflicting locks at or above its min_similarity, counted
+    // from the request. Empty keeps the plain threshold. Every scan then
+    // counts all holders in range, so diagnostics off no longer stops early.
+    std::vector<ConcurrencyBand> concurrency_bands;
+    // Time a granted request still needs before it can answer its caller.
+    // An acquire with less than this left before its deadline is shed.
+    std::chrono::milliseconds deadline_slack{0};
+    // Keeps up to pivot_count pivots, taken from the first granted locks
+    // that are not close to an existing pivot, plus each lock's angle to
+    // every pivot. By the triangle inequality on angles, a lock whose angle
+    // to some pivot differs from the query's by more than arccos(theta)
+    // cannot conflict, so it is skipped without a dot product. 0 disables it.
+    size_t pivot_count = 0;
+    // Splits the snapshot scan of any shard holding at least
+    // parallel_scan_min_locks locks across a pool of parallel_scan_threads
+    // workers; 0 threads keeps every scan on the calling thread. Without
+    // diagnostics the partitions stop as soon as one of them finds a
+    // conflict, like any other scan.
+    size_t parallel_scan_threads = 0;
+    size_t parallel_scan_min_locks = 16384;
+    // Tags a lock with the cluster of an earlier lock in its shard when its
+    // centroid is at least this similar to the cluster's center, so a burst
+    // of near-identical locks shares one bounding cap. A scan compares the
+    // query with each cap once and skips all of its members when the cap
+    // lies out of reach; otherwise the members are checked one by one. Only
+    // the last few clusters of a shard take new members. 0 disables it.
+    float cluster_similarity = 0.0f;
+    // Resolution of the timer wheel that expires leases; a lease runs out
+    // up to one tick late. The reaper thread starts with the first lease.
+    std::chrono::milliseconds lease_tick{10};
+};
+
+enum class AcquireStatus {
+    kGranted,
+    kDimensionMismatch,
+    // Shed, or gave up waiting, because it could no longer be granted in
+    // time to be useful.
+    kDeadlineExceeded,
+    // The caller's cancellation check fired while it was waiting.
+    kCancelled,
 };
 
 struct AcquireTrace {
+    AcquireStatus status = AcquireStatus::kGranted;
     bool waited = false;
+    // The most similar lock or waiter it waited on, or with diagnostics off
+    // the first one the arrival found.
     float blocking_similarity_score = 0.0f;
     std::string blocking_agent_id;
+    // Earlier waiters this acquire queued behind when it arrived; under
+    // QueuePolicy::kOvertake only writers a shared acquire let go first.
+    size_t queue_position = 0;
+    // The dimension the table is fixed to, set on kDimensionMismatch.
+    size_t table_dimension = 0;
+    // The locks this acquire was granted, one per embedding.
+    std::vector<uint64_t> lock_ids;
 };
 
+// Rows the scans considered and how many of them the pivot bound skipped.
+struct PivotPruningStats {
+    uint64_t rows_considered = 0;
+    uint64_t rows_pruned = 0;
+};
+
+// Cluster caps the scans compared a query with, and the member rows those
+// comparisons let them skip.
+struct ClusterScanStats {
+    uint64_t caps_checked = 0;
+    uint64_t rows_skipped = 0;
+};
+
+// Embeddings passed to acquire() must already be unit length (see
+// normalize_embedding in similarity_kernels.h); conflicts are then decided by
+// dot product alone. The first acquire fixes the table's dimension for good,
+// and later acquires of any other dimension return kDimensionMismatch.
 class ActiveLockTable {
 public:
+    using Clock = std::chrono::steady_clock;
+    // Polled while an acquire waits; returning true abandons the acquire.
+    using CancelCheck = std::function<bool()>;
+
+    explicit ActiveLockTable(const ActiveLockTableOptions& options = ActiveLockTableOptions());
+    ~ActiveLockTable();
+
+    // Waits for as long as the conflicting locks are held.
     AcquireTrace acquire(const std::string& agent_id,
                          const std::vector<float>& embedding,
-                         float threshold);
+                         float threshold,
+                         LockMode mode = LockMode::kExclusive);
 
+    // `deadline` is when the caller stops waiting for an answer. Among
+    // waiters freed by the same release the earliest deadline is granted
+    // first. A request that cannot be granted with deadline_slack to spare
+    // is shed, and a waiter that reaches that point or sees `cancelled`
+    // fire takes itself out of the table and returns kDeadlineExceeded or
+    // kCancelled without a lock.
+    //
+    // With `diagnostics` off the scan stops at the first conflicting lock,
+    // and the trace names that lock, found once when the wait begins,
+    // rather than the most similar blocker. The remaining blockers are
+    // picked up when the waiter is first woken.
+    AcquireTrace acquire_until(const std::string& agent_id,
+                               const std::vector<float>& embedding,
+                               float threshold,
+                               Clock::time_point deadline,
+                               const CancelCheck& cancelled = CancelCheck(),
+                               bool diagnostics = true,
+                               LockMode mode = LockMode::kExclusive);
+
+    // Locks every embedding for the agent at once, or none of them: the
+    // set is checked in one pass over the table and the request holds
+    // nothing while it waits, so agents taking overlapping sets in any
+    // order cannot deadlock. Each embedding becomes its own lock, checked
+    // against other agents' locks only, and release() drops them together.
+    // Deadline, cancellation, diagnostics and mode work as in acquire_until.
+    AcquireTrace acquire_all_until(const std::string& agent_id,
+                                   const std::vector<std::vector<float>>& embeddings,
+                                   float threshold,
+                                   Clock::time_point deadline,
+                                   const CancelCheck& cancelled = CancelCheck(),
+                                   bool diagnostics = true,
+                                   LockMode mode = LockMode::kExclusive);
+
+    AcquireTrace acquire_for(const std::string& agent_id,
+                             const std::vector<float>& embedding,
+                             float threshold,
+                             Clock::duration timeout,
+                             const CancelCheck& cancelled = CancelCheck());
+
+    // Releases every lock the agent holds and ends its lease.
     void release(const std::string& agent_id);
 
+    // Releases only those of the agent's locks named in `lock_ids`, such as
+    // the ones a single acquire was granted. The rest, and their lease, are
+    // kept; the lease ends with the last lock it covers.
+    void release(const std::string& agent_id, const std::vector<uint64_t>& lock_ids);
+
+    // Puts the agent's locks named in `lock_ids` on its lease, starting one
+    // if it has none, and renews the lease to run out `ttl` from now. The
+    // agent's other locks stay with the calls that took them and outlive
+    // the lease. Returns false when none of the named locks is held any
+    // more.
+    bool lease_locks(const std::string& agent_id,
+                     const std::vector<uint64_t>& lock_ids,
+                     Clock::duration ttl);
+
+    // Pushes the agent's lease out to run out `ttl` from now. Once it runs
+    // out the reaper releases the locks it covers as release() would, waking
+    // only their waiters. Returns false when the agent has no lease, which
+    // is also the case once it has run out.
+    bool renew_lease(const std::string& agent_id, Clock::duration ttl);
+
     size_t size() const;
 
+    size_t shard_count() const { return shards_.size(); }
+
+    PivotPruningStats pivot_pruning_stats() const;
+
+    ClusterScanStats cluster_scan_stats() const;
+
     void print_active_locks() const;
 
 private:
-    AcquireTrace overlap_trace(const std::vector<float>& embedding,
-                               float threshold);
+    // A blocked acquire. It is registered under every lock that blocked its
+    // last scan. Releases in different shards may count it down, so it has
+    // its own mutex; the release that takes pending_blockers to zero owns the
+    // waiter until it grants it, sheds it, or registers it again.
+    struct Waiter {
+        std::mutex mu;
+        std::condition_variable cv;
+        size_t pending_blockers = 0;
+        // Set once a release has granted or shed this acquire; trace.status
+        // tells which.
+        bool decided = false;
+
+        const std::string* agent_id = nullptr;
+        // One lock each, granted together.
+        std::vector<const std::vector<float>*> embeddings;
+        float threshold = 0.0f;
+        // Lowest similarity that counts against it; see counting_floor().
+        float floor = 0.0f;
+        LockMode mode = LockMode::kExclusive;
+        Clock::time_point deadline = Clock::time_point::max();
+        std::vector<size_t> probe;
+        // Every lock in the probe shards below this epoch has been checked.
+        // 0 after an early-stopped scan, when some blockers are not known
+        // yet, or when it waits on only some of the holders in a band and
+        // the rest must be counted again.
+        uint64_t scanned_epoch = 0;
+        bool diagnostics = true;
+        // Order in which acquires first blocked; lower is older.
+        uint64_t arrival = 0;
+        AcquireTrace trace;
+
+        // Queue bookkeeping, guarded by the mutexes of the home shards of
+        // its embeddings, where the waiter is listed as an intent until it
+        // is granted when tracks_intents() holds. Followers are later
+        // arrivals queued behind it; they move onto its first lock once it
+        // is granted.
+        std::vector<size_t> homes;
+        size_t bypassed = 0;
+        std::vector<Waiter*> followers;
+    };
+
+    struct LockRef {
+        uint64_t lock_id = 0;
+        size_t shard = 0;
+        // The lease covering the lock, or 0 while it belongs to the call
+        // that took it.
+        uint64_t lease = 0;
+    };
+
+    // `lease` is 0 until lease_locks is first called for the agent, and
+    // again once that lease ends.
+    struct AgentLocks {
+        std::vector<LockRef> refs;
+        uint64_t lease = 0;
+    };
+
+    // The wheel holds a timer for `scheduled`, the tick the lease was due at
+    // when last armed. A renewal sets `expires` to its own ttl from now,
+    // which may be earlier or later. An earlier one arms a new timer, and
+    // the reaper drops the old one when it fires; a later one keeps the
+    // timer, which the reaper re-arms when it fires before the lease has run
+    // out.
+    struct Lease {
+        std::string agent_id;
+        Clock::time_point expires;
+        uint64_t scheduled = 0;
+    };
+
+    // Near-identical locks of one shard: every member's centroid is at least
+    // options.cluster_similarity similar to `center`, which is a copy of the
+    // first member's. Scans only read the center. `members` counts the rows
+    // tagged with the cluster and is guarded by the shard mutex; a cluster
+    // that is still waiting for its second lock has none, since its seed row
+    // is only tagged once that lock joins.
+    struct LockCluster {
+        std::vector<float> center;
+        uint64_t seed_lock_id = 0;
+        size_t members = 0;
+    };
+
+    // Up to kBlockRows active locks in structure-of-arrays form: row i of
+    // centroids belongs to agent_ids[i], thresholds[i], modes[i] and
+    // lock_ids[i];
+    // quantized and halves mirror centroids row for row when the int8
+    // prefilter and the fp16 scan are on, and
+    // pivot_angles holds options.pivot_count angles per row when pivots are
+    // on (NaN for pivots chosen after the row was inserted).
+    // clusters holds each row's cluster, or null, when clustering is on.
+    // A block is never modified once a published snapshot refers to it;
+    // writers copy it first.
+    struct LockBlock {
+        CentroidMatrix centroids;
+        QuantizedMatrix quantized;
+        HalfMatrix halves;
+        std::vector<float> thresholds;
+        std::vector<LockMode> modes;
+        std::vector<float> pivot_angles;
+        std::vector<std::shared_ptr<LockCluster>> clusters;
+        std::vector<std::string> agent_ids;
+        std::vector<uint64_t> lock_ids;
+    };
+
+    // Immutable view of a shard that scans read without the shard mutex.
+    // It holds every lock with an id below `epoch` that was still active
+    // when it was published.
+    struct ShardSnapshot {
+        std::vector<std::shared_ptr<const LockBlock>> blocks;
+        size_t rows = 0;
+        uint64_t epoch = 0;
+    };
+
+    // One SimHash partition of the active locks. Row r lives in
+    // blocks[r / kBlockRows] at position r % kBlockRows; every block but the
+    // last is full.
+    //
+    // Lock ids come from one table-wide counter that is read inside the
+    // shard's mutex, so within a shard they double as insertion epochs.
+    // row_of_lock is ordered by id, which lets a scan visit just the locks
+    // inserted since a snapshot or a previous scan.
+    struct Shard {
+        std::mutex mu;
+        std::vector<std::shared_ptr<LockBlock>> blocks;
+        size_t rows = 0;
+        std::map<uint64_t, size_t> row_of_lock;
+        std::unordered_map<uint64_t, std::vector<Waiter*>> waiters_by_lock;
+        // Waiters homed here, when a queue policy is set.
+        std::vector<Waiter*> intents;
+        // Optional candidate index over the same locks.
+        std::unique_ptr<ConflictIndex> index;
+        std::vector<uint64_t> candidate_ids;
+        // The clusters new locks may still join, oldest first.
+        std::vector<std::shared_ptr<LockCluster>> open_clusters;
+
+        // snapshot_mu only guards swapping the pointer, never a scan.
+        std::mutex snapshot_mu;
+        std::shared_ptr<const ShardSnapshot> snapshot;
+    };
+
+    // The query side of a scan, prepared once per embedding of an acquire.
+    // The counters are added to the table-wide pivot and cluster statistics
+    // once the scan is done. `threshold` is the request's counting floor.
+    struct ScanQuery {
+        const std::vector<float>* embedding = nullptr;
+        QuantizedRow quantized;
+        float threshold = 0.0f;
+        LockMode mode = LockMode::kExclusive;
+        // Stop at the first conflict instead of collecting all of them.
+        bool first_conflict_only = false;
+        std::vector<float> pivot_angles;
+        float pivot_radius = 0.0f;
+        // A cluster whose center is less similar than this holds no member
+        // that reaches the threshold.
+        float cluster_floor = 0.0f;
+        // Whether each cluster met so far was out of reach. Every cluster in
+        // it is kept alive by a block the acquire still holds or has locked.
+        mutable std::unordered_map<const LockCluster*, bool> cluster_verdicts;
+        mutable uint64_t rows_considered = 0;
+        mutable uint64_t rows_pruned = 0;
+        mutable uint64_t caps_checked = 0;
+        mutable uint64_t rows_cluster_skipped = 0;
+    };
+
+    // A lock at or above the counting floor. agent_id points into the block that
+    // was scanned (or at a waiter being granted), so it is only valid while
+    // that block or waiter is kept alive. `query` is the index of the
+    // request's embedding it was found for.
+    struct BlockingHit {
+        LockRef ref;
+        float similarity = 0.0f;
+        const std::string* agent_id = nullptr;
+        size_t query = 0;
+    };
+
+    // An older waiter that an arrival has to queue behind.
+    struct QueuedHit {
+        Waiter* waiter = nullptr;
+        float similarity = 0.0f;
+    };
+
+    static constexpr size_t kBlockRows = 64;
+
+    AcquireTrace acquire_embeddings(const std::string& agent_id,
+                                    std::vector<const std::vector<float>*> embeddings,
+                                    float threshold,
+                                    Clock::time_point deadline,
+                                    const CancelCheck& cancelled,
+                                    bool diagnostics,
+                                    LockMode mode);
+
+    void check_row(const LockBlock& block,
+                   size_t slot,
+                   size_t shard_index,
+                   const ScanQuery& query,
+                   size_t query_index,
+                   std::vector<BlockingHit>& hits) const;
+
+    // Lock-free pass over a published snapshot, checking each row against
+    // every query while it is in cache. Returns false if it stopped at a
+    // first conflict before the end.
+    bool scan_snapshot(const ShardSnapshot& snapshot,
+                       size_t shard_index,
+                       const std::vector<ScanQuery>& queries,
+                       std::vector<BlockingHit>& hits) const;
+
+    // scan_snapshot split into block ranges on scan_pool_, with the same
+    // return value. After an early stop `hits` holds at least one, but not
+    // necessarily every, blocking lock.
+    bool scan_snapshot_parallel(const ShardSnapshot& snapshot,
+                                size_t shard_index,
+                                const std::vector<ScanQuery>& queries,
+                                std::vector<BlockingHit>& hits) const;
+
+    // Appends every lock in `shard` that blocks a query to `hits`. Only
+    // locks stamped with an epoch >= since_epoch are checked; 0 scans the
+    // whole shard. A first-conflict-only query stops at its first hit. The
+    // caller holds shard.mu.
+    void scan_shard(Shard& shard,
+                    size_t shard_index,
+                    const std::vector<ScanQuery>& queries,
+                    uint64_t since_epoch,
+                    std::vector<BlockingHit>& hits);
+
+    // The request's threshold, or the lowest concurrency band below it.
+    float counting_floor(float threshold) const;
+
+    // Keeps only the hits a request must wait out: for each of its
+    // embeddings every hit at or above its threshold, and enough of the
+    // closest holders to bring each band back under its limit. A lock hit
+    // by several embeddings is kept once. Empty when the request fits.
+    // Returns true if hits were dropped, in which case the holders still in
+    // range must be counted again once it is woken.
+    bool keep_blocking_hits(std::vector<BlockingHit>& hits, float threshold) const;
+
+    // One query per embedding of the waiter, at its counting floor, with
+    // the int8 codes, pivot angles and cluster floor the options call for.
+    void prepare_queries(const Waiter& waiter,
+                         bool first_conflict_only,
+                         std::vector<ScanQuery>& queries) const;
+
+    // Adds the queries' counters to the pivot and cluster statistics.
+    void record_scan_stats(const std::vector<ScanQuery>& queries);
+
+    // True when the row's cluster cap keeps every member below the query's
+    // threshold. Each cluster is compared with the query once.
+    bool cluster_out_of_reach(const LockCluster& cluster, const ScanQuery& query) const;
+
+    // Finds an open cluster in the shard for a new lock, tagging a waiting
+    // seed row once it gains its second lock, or opens a cluster seeded by
+    // the new lock and returns null. The caller holds shard.mu.
+    std::shared_ptr<LockCluster> join_cluster(Shard& shard,
+                                              uint64_t lock_id,
+                                              const std::vector<float>& embedding);
+
+    // Drops one member; a cluster left empty closes.
+    void leave_cluster(Shard& shard, LockCluster& cluster);
+
+    // Fills the query's angles to the pivots chosen so far.
+    void prepare_pivots(ScanQuery& query) const;
+
+    // Angles from `vector` to the first `count` pivots.
+    void pivot_angles_of(const float* vector, size_t count, float* out) const;
+
+    // Makes the centroid a pivot while there is room and it is not close to
+    // an existing one.
+    void maybe_add_pivot(const float* centroid);
+
+    // True when a full scan of the shard should go through its index.
+    bool use_index(const Shard& shard, size_t rows) const;
+
+    std::shared_ptr<const ShardSnapshot> load_snapshot(Shard& shard) const;
+
+    // Publishes the shard's current blocks. The caller holds shard.mu.
+    void publish_snapshot(Shard& shard);
+
+    // Returns the block for writing, copying it first if a snapshot shares it.
+    LockBlock& writable_block(Shard& shard, size_t block_index);
+
+    // Inserts a granted lock into its home shard and records it for the
+    // agent. The caller holds the home shard and publishes its snapshot.
+    LockRef insert_lock(const std::string& agent_id,
+                        const std::vector<float>& embedding,
+                        float threshold,
+                        LockMode mode);
+
+    // True when waiters are listed as intents in their home shard, which a
+    // queue policy or writer preference needs.
+    bool tracks_intents() const;
+
+    // Appends the queued waiters in the probe shards that the arrival may
+    // not overtake under the queue policy or writer preference, counting
+    // the ones it bypasses.
+    // The caller holds the probe shards.
+    void find_queued_ahead(const Waiter& arrival, std::vector<QueuedHit>& ahead);
+
+    // Records the strongest hit in the waiter's trace and registers the
+    // waiter under every lock hit and behind every queued one. `hits` are
+    // the ones left by keep_blocking_hits. The caller
+    // holds the shards of all hits.
+    void block_waiter(Waiter& waiter,
+                      const std::vector<BlockingHit>& hits,
+                      const std::vector<QueuedHit>& ahead);
+
+    // Drops a granted or departing waiter from its home shards' intents.
+    void remove_intent(Waiter& waiter);
+
+    // True when a request with this deadline can no longer be answered in time.
+    bool misses_deadline(Clock::time_point deadline, Clock::time_point now) const;
+
+    // Takes a waiter that will not be granted out of the queue. Arrivals
+    // queued only behind it are appended to `freed`. The caller holds the
+    // waiter's home shards.
+    void withdraw_waiter(Waiter& waiter, std::vector<Waiter*>& freed);
+
+    // Called by a waiter that stops waiting. Returns false when a release
+    // already owns the waiter and is about to decide it; otherwise removes
+    // every registration of the waiter and returns true.
+    bool abandon_waiter(Waiter& waiter);
+
+    // Decides every waiter whose blockers a release just cleared, in rounds
+    // of admit_batch until shedding frees no further waiters.
+    void admit_waiters(std::vector<Waiter*> ready);
+
+    // One similarity matrix for the batch: each waiter's embeddings against
+    // the locks inserted since its last scan and against the other ready
+    // waiters. A waiter without a valid scanned_epoch is first scanned in
+    // full on its own, so it does not widen the matrix for the rest.
+    // Entries near a waiter's floor are recomputed with check_row's kernel.
+    // Waiters past their deadline are shed. A greedy pass, earliest deadline
+    // then oldest first, grants a maximal set of the rest that conflict with
+    // neither the table nor each other; the others wait on new blockers.
+    void admit_batch(const std::vector<Waiter*>& ready, std::vector<Waiter*>& freed);
+
+    size_t append_row(Shard& shard,
+                      uint64_t lock_id,
+                      const std::vector<float>& embedding,
+                      float threshold,
+                      LockMode mode,
+                      std::shared_ptr<LockCluster> cluster,
+                      const std::string& agent_id);
+
+    // Fixes the table to the dimension of its first acquire. Later calls
+    // are no-ops; a different dimension is rejected for good.
+    void adopt_dimension(size_t dimension);
+
+    void reset_shard(Shard& shard, size_t dimension);
+
+    void remove_row(Shard& shard, size_t row);
+
+    // Drops the lock's row and appends waiters that were only waiting on it
+    // to `ready`. The caller holds shard.mu.
+    void remove_lock(Shard& shard, uint64_t lock_id, std::vector<Waiter*>& ready);
+
+    // Removes locks already taken out of locks_by_agent_ and admits the
+    // waiters they held back.
+    void release_locks(const std::vector<LockRef>& locks);
+
+    // The wheel tick `time` falls in. A lease is armed for the tick after
+    // the one it expires in, so it never fires early.
+    uint64_t lease_tick_at(Clock::time_point time) const;
+
+    // The reaper thread: sleeps until the wheel's next occupied slot comes
+    // round, advances it, and releases the agents whose leases ran out.
+    void reap_leases();
+
+    // Releases the agent's locks that are still under `lease`.
+    void expire_lease(const std::string& agent_id, uint64_t lease);
+
+    // Sets the expiry of lease `id` and arms a timer for it if none is due
+    // early enough. Called with lease_mu_ held.
+    void arm_lease(uint64_t id, Lease& lease, Clock::time_point expires);
+
+    // Drops an agent that holds no more locks, and its lease. Called with
+    // agents_mu_ held.
+    void forget_agent(std::unordered_map<std::string, AgentLocks>::iterator it);
+
+    ActiveLockTableOptions options_;
+
+    // Held shared by every acquire and release, and exclusively only to fix
+    // the dimension on the first acquire. Guards dimension_, dot_, sharder_
+    // and the shards' layout.
+    mutable std::shared_mutex layout_mu_;
+    size_t dimension_ = 0;
+    // Specialized for dimension_ when it is one of the common sizes.
+    DotKernel dot_ = dot_product;
+    SimHashSharder sharder_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> next_epoch_{1};
+    std::atomic<size_t> active_count_{0};
+    std::atomic<uint64_t> next_arrival_{0};
+
+    // pivot_count rows of dimension_ floats, sized when the dimension is
+    // adopted. Rows below pivots_ready_ are immutable; new ones are written
+    // under pivots_mu_ and then published by bumping pivots_ready_.
+    std::vector<float> pivots_;
+    std::atomic<size_t> pivots_ready_{0};
+    std::mutex pivots_mu_;
+    std::atomic<uint64_t> pivot_rows_considered_{0};
+    std::atomic<uint64_t> pivot_rows_pruned_{0};
+    std::atomic<uint64_t> cluster_caps_checked_{0};
+    std::atomic<uint64_t> cluster_rows_skipped_{0};
+
+    // Started with the table when parallel_scan_threads > 0.
+    std::unique_ptr<ScanPool> scan_pool_;
 
-    float cosine_similarity(const std::vector<float>& a,
-                            const std::vector<float>& b);
+    // Taken inside a shard mutex on acquire, and on its own on release.
+    std::mutex agents_mu_;
+    std::unordered_map<std::string, AgentLocks> locks_by_agent_;
 
-    std::vector<SemanticLock> active_;
-    mutable std::mutex mu_;
-    std::condition_variable cv_;
+    // Taken inside agents_mu_ by the lease calls and release, and on its own by
+    // the reaper. Guards everything below.
+    std::mutex lease_mu_;
+    std::condition_variable reaper_cv_;
+    std::unordered_map<uint64_t, Lease> leases_;
+    uint64_t next_lease_ = 1;
+    Clock::time_point lease_origin_;
+    TimerWheel lease_wheel_;
+    bool reaper_stopping_ = false;
+    std::thread reaper_;
 };
@@ -0,0 +1,86 @@
+// Implements the aligned, growable centroid matrix behind ActiveLockTable.
+// Growth is geometric, and removal swaps the last row into the hole so the
+// live rows always stay packed at the front of the allocation.
+
+#include "centroid_matrix.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace {
+
+constexpr size_t kFloatsPerLine = CentroidMatrix::kAlignment / sizeof(float);
+constexpr size_t kInitialCapacity = 16;
+
+size_t round_up_to_line(size_t floats) {
+    return ((floats + kFloatsPerLine - 1) / kFloatsPerLine) * kFloatsPerLine;
+}
+
+}  // namespace
+
+CentroidMatrix::CentroidMatrix(const CentroidMatrix& other)
+    : dimension_(other.dimension_),
+      stride_(other.stride_) {
+    if (other.size_ > 0) {
+        grow(other.capacity_);
+        std::memcpy(data_.get(), other.data_.get(), other.size_ * stride_ * sizeof(float));
+        size_ = other.size_;
+    }
+}
+
+CentroidMatrix& CentroidMatrix::operator=(const CentroidMatrix& other) {
+    if (this != &other) {
+        CentroidMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void CentroidMatrix::reset(size_t dimension) {
+    data_.reset();
+    dimension_ = dimension;
+    stride_ = round_up_to_line(dimension);
+    size_ = 0;
+    capacity_ = 0;
+}
+
+size_t CentroidMatrix::push_back(const float* values) {
+    if (size_ == capacity_) {
+        grow(size_ + 1);
+    }
+    float* dest = data_.get() + size_ * stride_;
+    std::memcpy(dest, values, dimension_ * sizeof(float));
+    std::fill(dest + dimension_, dest + stride_, 0.0f);
+    return size_++;
+}
+
+void CentroidMatrix::set_row(size_t index, const float* values) {
+    std::memcpy(data_.get() + index * stride_, values, dimension_ * sizeof(float));
+}
+
+size_t CentroidMatrix::swap_remove(size_t index) {
+    const size_t last = size_ - 1;
+    if (index != last) {
+        std::memcpy(data_.get() + index * stride_,
+                    data_.get() + last * stride_,
+                    stride_ * sizeof(float));
+    }
+    --size_;
+    return last;
+}
+
+void CentroidMatrix::grow(size_t min_capacity) {
+    const size_t new_capacity = std::max({min_capacity, kInitialCapacity, capacity_ * 2});
+    const size_t bytes = new_capacity * stride_ * sizeof(float);
+    float* fresh = static_cast<float*>(std::aligned_alloc(kAlignment, bytes));
+    if (fresh == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (size_ > 0) {
+        std::memcpy(fresh, data_.get(), size_ * stride_ * sizeof(float));
+    }
+    data_.reset(fresh);
+    capacity_ = new_capacity;
+}
@@ -0,0 +1,57 @@
+// Declares the contiguous centroid storage used by the active lock table.
+// Rows are fixed-dimension float vectors padded to whole cache lines, so a
+// conflict scan streams straight through one aligned allocation.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+
+class CentroidMatrix {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    CentroidMatrix() = default;
+    CentroidMatrix(const CentroidMatrix& other);
+    CentroidMatrix& operator=(const CentroidMatrix& other);
+    CentroidMatrix(CentroidMatrix&&) = default;
+    CentroidMatrix& operator=(CentroidMatrix&&) = default;
+
+    // Drops every row and switches to a new row dimension.
+    void reset(size_t dimension);
+
+    size_t dimension() const { return dimension_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // Distance in floats between consecutive rows; a multiple of 16.
+    size_t stride() const { return stride_; }
+
+    const float* row(size_t index) const { return data_.get() + index * stride_; }
+
+    // Appends a row of dimension() floats and returns its index.
+    size_t push_back(const float* values);
+
+    // Overwrites an existing row with dimension() floats.
+    void set_row(size_t index, const float* values);
+
+    // Removes a row in O(1) by moving the last row into its place.
+    // Returns the index the last row was moved from, which equals `index`
+    // when the removed row was already last.
+    size_t swap_remove(size_t index);
+
+private:
+    struct AlignedFree {
+        void operator()(float* ptr) const { std::free(ptr); }
+    };
+
+    void grow(size_t min_capacity);
+
+    std::unique_ptr<float[], AlignedFree> data_;
+    size_t dimension_ = 0;
+    size_t stride_ = 0;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
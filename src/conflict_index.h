@@ -0,0 +1,27 @@
+// Declares the optional candidate index that ActiveLockTable can consult
+// instead of scanning every active lock. Implementations only propose
+// candidates; the table re-checks each one exactly before it counts as a hit.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ConflictIndex {
+public:
+    virtual ~ConflictIndex() = default;
+
+    // Centroids are unit length and have the dimension the index was built for.
+    virtual void insert(uint64_t lock_id, const float* centroid) = 0;
+
+    virtual void remove(uint64_t lock_id) = 0;
+
+    // Appends the ids of locks whose similarity to `query` may reach
+    // `threshold`. May miss locks if the index is approximate.
+    virtual void candidates(const float* query,
+                            float threshold,
+                            std::vector<uint64_t>& out) = 0;
+
+    virtual size_t size() const = 0;
+};
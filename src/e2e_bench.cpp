@@ -3,6 +3,7 @@
 // It coordinates Docker startup, scenario execution, validation, and readable output.
 
 #include "dscc.grpc.pb.h"
+#include "similarity_kernels.h"
 #include "threadsafe_log.h"
 
 #include <grpcpp/grpcpp.h>
@@ -421,23 +422,22 @@ std::string read_text_file(const fs::path& path) {
 
 float cosine_similarity(const std::vector<float>& a,
                         const std::vector<float>& b) {
-    if (a.empty() || b.empty() || a.size() != b.size()) {
-        return 0.0f;
-    }
-
-    double dot = 0.0;
-    double norm_a = 0.0;
-    double norm_b = 0.0;
-    for (size_t i = 0; i < a.size(); ++i) {
-        dot += static_cast<double>(a[i]) * static_cast<double>(b[i]);
-        norm_a += static_cast<double>(a[i]) * static_cast<double>(a[i]);
-        norm_b += static_cast<double>(b[i]) * static_cast<double>(b[i]);
+    if (a.empty() || a.size() != b.size()) {
+        throw std::runtime_error("cannot compare embeddings of " + std::to_string(a.size()) +
+                                 " and " + std::to_string(b.size()) + " dimensions");
     }
 
-    if (norm_a <= 0.0 || norm_b <= 0.0) {
+    // The same fixed-dimension kernel the lock table resolves for this size.
+    // The documents are not unit length, so the norms are taken here.
+    const DotKernel dot = dot_kernel_for_dimension(a.size());
+    const float norm_a = dot(a.data(), a.data(), a.size());
+    const float norm_b = dot(b.data(), b.data(), b.size());
+    if (norm_a <= 0.0f || norm_b <= 0.0f) {
         return 0.0f;
     }
-    return static_cast<float>(dot / (std::sqrt(norm_a) * std::sqrt(norm_b)));
+    const float similarity = dot(a.data(), b.data(), a.size()) /
+                             (std::sqrt(norm_a) * std::sqrt(norm_b));
+    return std::max(-1.0f, std::min(1.0f, similarity));
 }
 
 Config load_config() {
@@ -893,6 +893,10 @@ void print_timeline(const std::vector<AgentOutcome>& outcomes,
                          << format_float(outcome.response.blocking_similarity_score())
                          << " >= theta " << format_float(theta);
             }
+            if (outcome.response.queue_position() > 0) {
+                acquired << " (queued behind " << outcome.response.queue_position()
+                         << " earlier request(s))";
+            }
         }
         push_event(relative_unix_ms(outcome.response.lock_acquired_unix_ms(), unix_base_ms),
                    outcome.response.lock_wait_ms() > 0 ? ansi::kYellow : ansi::kGreen,
@@ -0,0 +1,92 @@
+// Implements the aligned fp16 centroid copy used by half-precision scans.
+// Rows are converted once on insert; removal swaps the last row into the
+// hole exactly like CentroidMatrix, so both stay indexed by the same slot.
+
+#include "half_matrix.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace {
+
+constexpr size_t kHalvesPerLine = HalfMatrix::kAlignment / sizeof(uint16_t);
+constexpr size_t kInitialCapacity = 16;
+
+size_t round_up_to_line(size_t halves) {
+    return ((halves + kHalvesPerLine - 1) / kHalvesPerLine) * kHalvesPerLine;
+}
+
+}  // namespace
+
+HalfMatrix::HalfMatrix(const HalfMatrix& other)
+    : dimension_(other.dimension_),
+      stride_(other.stride_) {
+    if (other.size_ > 0) {
+        grow(other.capacity_);
+        std::memcpy(data_.get(), other.data_.get(), other.size_ * stride_ * sizeof(uint16_t));
+        size_ = other.size_;
+    }
+}
+
+HalfMatrix& HalfMatrix::operator=(const HalfMatrix& other) {
+    if (this != &other) {
+        HalfMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void HalfMatrix::reset(size_t dimension) {
+    data_.reset();
+    dimension_ = dimension;
+    stride_ = round_up_to_line(dimension);
+    size_ = 0;
+    capacity_ = 0;
+}
+
+size_t HalfMatrix::push_back(const float* values) {
+    if (size_ == capacity_) {
+        grow(size_ + 1);
+    }
+    uint16_t* dest = data_.get() + size_ * stride_;
+    convert_to_half(values, dest, dimension_);
+    std::fill(dest + dimension_, dest + stride_, uint16_t{0});
+    return size_++;
+}
+
+void HalfMatrix::copy_row(size_t index, const HalfMatrix& source, size_t source_index) {
+    std::memcpy(data_.get() + index * stride_, source.row(source_index),
+                stride_ * sizeof(uint16_t));
+}
+
+size_t HalfMatrix::swap_remove(size_t index) {
+    const size_t last = size_ - 1;
+    if (index != last) {
+        std::memcpy(data_.get() + index * stride_,
+                    data_.get() + last * stride_,
+                    stride_ * sizeof(uint16_t));
+    }
+    --size_;
+    return last;
+}
+
+float HalfMatrix::dot(const float* query, size_t index) const {
+    return dot_product_half(query, row(index), dimension_);
+}
+
+void HalfMatrix::grow(size_t min_capacity) {
+    const size_t new_capacity = std::max({min_capacity, kInitialCapacity, capacity_ * 2});
+    const size_t bytes = new_capacity * stride_ * sizeof(uint16_t);
+    uint16_t* fresh = static_cast<uint16_t*>(std::aligned_alloc(kAlignment, bytes));
+    if (fresh == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (size_ > 0) {
+        std::memcpy(fresh, data_.get(), size_ * stride_ * sizeof(uint16_t));
+    }
+    data_.reset(fresh);
+    capacity_ = new_capacity;
+}
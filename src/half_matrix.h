@@ -0,0 +1,60 @@
+// Declares the fp16 shadow copy of the active lock centroids.
+// Rows are IEEE half precision padded to whole cache lines, so a conflict scan
+// streams half the bytes of the fp32 CentroidMatrix it mirrors row for row.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+class HalfMatrix {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    // Largest |q.x - q.x~| for unit-length q and x, where x~ is x rounded to
+    // fp16: each element moves by at most 2^-11 of itself, so
+    // |q.(x - x~)| <= ||x - x~|| <= 2^-11 ||x||. Padded for fp32 accumulation.
+    static constexpr float kUnitRoundingBound = 4.9e-4f;
+
+    HalfMatrix() = default;
+    HalfMatrix(const HalfMatrix& other);
+    HalfMatrix& operator=(const HalfMatrix& other);
+    HalfMatrix(HalfMatrix&&) = default;
+    HalfMatrix& operator=(HalfMatrix&&) = default;
+
+    void reset(size_t dimension);
+
+    size_t dimension() const { return dimension_; }
+    size_t size() const { return size_; }
+
+    const uint16_t* row(size_t index) const { return data_.get() + index * stride_; }
+
+    // Rounds a row of dimension() floats to fp16 and appends it; returns its
+    // index.
+    size_t push_back(const float* values);
+
+    // Overwrites row `index` with row `source_index` of `source`, which must
+    // have the same dimension.
+    void copy_row(size_t index, const HalfMatrix& source, size_t source_index);
+
+    // Mirrors CentroidMatrix::swap_remove so row indices stay in step.
+    size_t swap_remove(size_t index);
+
+    // dot(query, row) with the row widened back to fp32.
+    float dot(const float* query, size_t index) const;
+
+private:
+    struct AlignedFree {
+        void operator()(uint16_t* ptr) const { std::free(ptr); }
+    };
+
+    void grow(size_t min_capacity);
+
+    std::unique_ptr<uint16_t[], AlignedFree> data_;
+    size_t dimension_ = 0;
+    size_t stride_ = 0;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,338 @@
+// Implements the HNSW conflict index used when CONFLICT_INDEX=hnsw.
+// Similarity is the dot product of unit vectors, so "closer" means larger.
+// Each shard of the ActiveLockTable owns its own index and only calls it
+// with that shard's mutex held; the index has no locking.
+
+#include "hnsw_index.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+namespace {
+
+constexpr int kMaxLevel = 16;
+
+// Candidates within this margin below the threshold are still returned so
+// the table's exact re-check, not float rounding here, has the final say.
+constexpr float kThresholdSlack = 1e-4f;
+
+}  // namespace
+
+HnswIndex::HnswIndex(size_t dimension, const HnswParams& params)
+    : dimension_(dimension),
+      params_(params),
+      level_multiplier_(1.0 / std::log(static_cast<double>(std::max<size_t>(params.m, 2)))),
+      rng_(0x9e3779b97f4a7c15ULL) {
+    params_.m = std::max<size_t>(params_.m, 2);
+    params_.ef_construction = std::max(params_.ef_construction, params_.m);
+    params_.ef_search = std::max<size_t>(params_.ef_search, 1);
+}
+
+void HnswIndex::insert(uint64_t lock_id, const float* centroid) {
+    if (slot_of_lock_.count(lock_id) != 0) {
+        return;
+    }
+
+    uint32_t slot = 0;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        vectors_.resize(vectors_.size() + dimension_);
+    }
+    std::memcpy(vectors_.data() + static_cast<size_t>(slot) * dimension_,
+                centroid,
+                dimension_ * sizeof(float));
+
+    const int level = random_level();
+    nodes_[slot].lock_id = lock_id;
+    nodes_[slot].level = level;
+    nodes_[slot].links.assign(static_cast<size_t>(level) + 1, {});
+    slot_of_lock_.emplace(lock_id, slot);
+
+    if (max_level_ < 0) {
+        entry_point_ = slot;
+        max_level_ = level;
+        return;
+    }
+
+    const float* query = vector_of(slot);
+    uint32_t current = entry_point_;
+    if (level < max_level_) {
+        current = greedy_descend(query, current, max_level_, level);
+    }
+    for (int l = std::min(level, max_level_); l >= 0; --l) {
+        std::vector<Scored> found = search_layer(query, current, params_.ef_construction, l);
+        // A freed slot may still be the target of stale links, so the new
+        // node can find itself; never link it to itself.
+        found.erase(std::remove_if(found.begin(), found.end(),
+                                   [slot](const Scored& s) { return s.second == slot; }),
+                    found.end());
+        if (found.empty()) {
+            continue;
+        }
+        nodes_[slot].links[static_cast<size_t>(l)] = select_neighbors(found, params_.m);
+        for (const uint32_t neighbor : nodes_[slot].links[static_cast<size_t>(l)]) {
+            add_link(neighbor, slot, l);
+        }
+        current = found.front().second;
+    }
+
+    if (level > max_level_) {
+        max_level_ = level;
+        entry_point_ = slot;
+    }
+}
+
+void HnswIndex::remove(uint64_t lock_id) {
+    auto it = slot_of_lock_.find(lock_id);
+    if (it == slot_of_lock_.end()) {
+        return;
+    }
+    const uint32_t slot = it->second;
+    slot_of_lock_.erase(it);
+
+    const int level = nodes_[slot].level;
+    for (int l = 0; l <= level; ++l) {
+        const std::vector<uint32_t> former = nodes_[slot].links[static_cast<size_t>(l)];
+        for (const uint32_t neighbor : former) {
+            if (nodes_[neighbor].level < l) {
+                continue;
+            }
+            std::vector<uint32_t>& links = nodes_[neighbor].links[static_cast<size_t>(l)];
+            auto pos = std::find(links.begin(), links.end(), slot);
+            if (pos == links.end()) {
+                continue;
+            }
+            links.erase(pos);
+
+            // Offer the removed node's other neighbours as replacements.
+            std::vector<uint32_t> pool = links;
+            for (const uint32_t other : former) {
+                if (other != neighbor && nodes_[other].level >= l &&
+                    std::find(pool.begin(), pool.end(), other) == pool.end()) {
+                    pool.push_back(other);
+                }
+            }
+            const float* base = vector_of(neighbor);
+            std::vector<Scored> scored;
+            scored.reserve(pool.size());
+            for (const uint32_t candidate : pool) {
+                scored.emplace_back(similarity(base, candidate), candidate);
+            }
+            std::sort(scored.begin(), scored.end(), std::greater<Scored>());
+            links = select_neighbors(scored, max_links(l));
+        }
+    }
+
+    nodes_[slot].level = -1;
+    nodes_[slot].links.clear();
+    free_slots_.push_back(slot);
+
+    if (slot_of_lock_.empty()) {
+        max_level_ = -1;
+        entry_point_ = 0;
+    } else if (slot == entry_point_) {
+        pick_new_entry_point();
+    }
+}
+
+void HnswIndex::candidates(const float* query,
+                           float threshold,
+                           std::vector<uint64_t>& out) {
+    if (max_level_ < 0) {
+        return;
+    }
+
+    const uint32_t start = greedy_descend(query, entry_point_, max_level_, 0);
+    const std::vector<Scored> found = search_layer(query, start, params_.ef_search, 0);
+
+    // Locks above a high threshold sit in tight clusters, so walking the
+    // bottom layer outward from every hit recovers the members the beam
+    // search pushed out of its result set.
+    const float floor = threshold - kThresholdSlack;
+    const uint32_t epoch = next_visit_epoch();
+    std::vector<uint32_t> frontier;
+    for (const Scored& entry : found) {
+        visit_marks_[entry.second] = epoch;
+        if (entry.first >= floor) {
+            out.push_back(nodes_[entry.second].lock_id);
+            frontier.push_back(entry.second);
+        }
+    }
+    while (!frontier.empty()) {
+        const uint32_t current = frontier.back();
+        frontier.pop_back();
+        for (const uint32_t neighbor : nodes_[current].links[0]) {
+            if (nodes_[neighbor].level < 0 || visit_marks_[neighbor] == epoch) {
+                continue;
+            }
+            visit_marks_[neighbor] = epoch;
+            if (similarity(query, neighbor) >= floor) {
+                out.push_back(nodes_[neighbor].lock_id);
+                frontier.push_back(neighbor);
+            }
+        }
+    }
+}
+
+const float* HnswIndex::vector_of(uint32_t slot) const {
+    return vectors_.data() + static_cast<size_t>(slot) * dimension_;
+}
+
+float HnswIndex::similarity(const float* query, uint32_t slot) const {
+    return dot_product(query, vector_of(slot), dimension_);
+}
+
+size_t HnswIndex::max_links(int level) const {
+    return level == 0 ? params_.m * 2 : params_.m;
+}
+
+int HnswIndex::random_level() {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double draw = std::max(uniform(rng_), 1e-12);
+    return std::min(kMaxLevel, static_cast<int>(-std::log(draw) * level_multiplier_));
+}
+
+uint32_t HnswIndex::next_visit_epoch() {
+    if (visit_marks_.size() < nodes_.size()) {
+        visit_marks_.resize(nodes_.size(), 0);
+    }
+    if (++visit_epoch_ == 0) {
+        std::fill(visit_marks_.begin(), visit_marks_.end(), 0);
+        visit_epoch_ = 1;
+    }
+    return visit_epoch_;
+}
+
+uint32_t HnswIndex::greedy_descend(const float* query,
+                                   uint32_t entry,
+                                   int from_level,
+                                   int to_level) {
+    uint32_t current = entry;
+    float current_similarity = similarity(query, current);
+    for (int level = from_level; level > to_level; --level) {
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (const uint32_t neighbor : nodes_[current].links[static_cast<size_t>(level)]) {
+                if (nodes_[neighbor].level < level) {
+                    continue;
+                }
+                const float s = similarity(query, neighbor);
+                if (s > current_similarity) {
+                    current = neighbor;
+                    current_similarity = s;
+                    improved = true;
+                }
+            }
+        }
+    }
+    return current;
+}
+
+std::vector<HnswIndex::Scored> HnswIndex::search_layer(const float* query,
+                                                       uint32_t entry,
+                                                       size_t ef,
+                                                       int level) {
+    const uint32_t epoch = next_visit_epoch();
+    std::priority_queue<Scored> frontier;
+    std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>> best;
+
+    visit_marks_[entry] = epoch;
+    const Scored start(similarity(query, entry), entry);
+    frontier.push(start);
+    best.push(start);
+
+    while (!frontier.empty()) {
+        const Scored current = frontier.top();
+        if (best.size() >= ef && current.first < best.top().first) {
+            break;
+        }
+        frontier.pop();
+        for (const uint32_t neighbor : nodes_[current.second].links[static_cast<size_t>(level)]) {
+            if (nodes_[neighbor].level < level || visit_marks_[neighbor] == epoch) {
+                continue;
+            }
+            visit_marks_[neighbor] = epoch;
+            const float s = similarity(query, neighbor);
+            if (best.size() < ef || s > best.top().first) {
+                frontier.emplace(s, neighbor);
+                best.emplace(s, neighbor);
+                if (best.size() > ef) {
+                    best.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<Scored> result;
+    result.reserve(best.size());
+    while (!best.empty()) {
+        result.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+std::vector<uint32_t> HnswIndex::select_neighbors(const std::vector<Scored>& candidates,
+                                                  size_t max_count) const {
+    std::vector<uint32_t> selected;
+    std::vector<uint32_t> pruned;
+    selected.reserve(max_count);
+    for (const Scored& candidate : candidates) {
+        if (selected.size() >= max_count) {
+            break;
+        }
+        bool diverse = true;
+        for (const uint32_t kept : selected) {
+            if (similarity(vector_of(candidate.second), kept) > candidate.first) {
+                diverse = false;
+                break;
+            }
+        }
+        (diverse ? selected : pruned).push_back(candidate.second);
+    }
+    // Top up with pruned candidates so deletions cannot starve a node of links.
+    for (size_t i = 0; i < pruned.size() && selected.size() < max_count; ++i) {
+        selected.push_back(pruned[i]);
+    }
+    return selected;
+}
+
+void HnswIndex::add_link(uint32_t from, uint32_t to, int level) {
+    std::vector<uint32_t>& links = nodes_[from].links[static_cast<size_t>(level)];
+    if (std::find(links.begin(), links.end(), to) != links.end()) {
+        return;
+    }
+    links.push_back(to);
+    if (links.size() <= max_links(level)) {
+        return;
+    }
+
+    const float* base = vector_of(from);
+    std::vector<Scored> scored;
+    scored.reserve(links.size());
+    for (const uint32_t neighbor : links) {
+        scored.emplace_back(similarity(base, neighbor), neighbor);
+    }
+    std::sort(scored.begin(), scored.end(), std::greater<Scored>());
+    links = select_neighbors(scored, max_links(level));
+}
+
+void HnswIndex::pick_new_entry_point() {
+    max_level_ = -1;
+    for (uint32_t slot = 0; slot < nodes_.size(); ++slot) {
+        if (nodes_[slot].level > max_level_) {
+            max_level_ = nodes_[slot].level;
+            entry_point_ = slot;
+        }
+    }
+}
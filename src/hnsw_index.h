@@ -0,0 +1,81 @@
+// Declares an in-memory HNSW graph over the active lock centroids.
+// It is an optional ConflictIndex: acquire() asks it for nearby locks instead
+// of scanning the whole table, and release() deletes nodes in place.
+
+#pragma once
+
+#include "conflict_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct HnswParams {
+    size_t m = 16;
+    size_t ef_construction = 100;
+    size_t ef_search = 64;
+};
+
+class HnswIndex final : public ConflictIndex {
+public:
+    HnswIndex(size_t dimension, const HnswParams& params);
+
+    void insert(uint64_t lock_id, const float* centroid) override;
+
+    // Unlinks the node and reconnects its former neighbours to each other so
+    // the graph stays navigable under heavy churn.
+    void remove(uint64_t lock_id) override;
+
+    // Beam search on the bottom layer, then a breadth-first walk outward from
+    // every hit so clusters of locks above the threshold are returned whole.
+    void candidates(const float* query,
+                    float threshold,
+                    std::vector<uint64_t>& out) override;
+
+    size_t size() const override { return slot_of_lock_.size(); }
+
+private:
+    struct Node {
+        uint64_t lock_id = 0;
+        int level = -1;  // -1 marks a free slot
+        std::vector<std::vector<uint32_t>> links;
+    };
+
+    // (similarity to the query, slot)
+    using Scored = std::pair<float, uint32_t>;
+
+    const float* vector_of(uint32_t slot) const;
+    float similarity(const float* query, uint32_t slot) const;
+    size_t max_links(int level) const;
+    int random_level();
+    uint32_t next_visit_epoch();
+
+    uint32_t greedy_descend(const float* query, uint32_t entry, int from_level, int to_level);
+
+    // Best-first search of one layer; returns up to `ef` nodes, best first.
+    std::vector<Scored> search_layer(const float* query, uint32_t entry, size_t ef, int level);
+
+    // HNSW neighbour-selection heuristic: prefers candidates that are closer
+    // to the base node than to any neighbour already picked.
+    std::vector<uint32_t> select_neighbors(const std::vector<Scored>& candidates,
+                                           size_t max_count) const;
+
+    void add_link(uint32_t from, uint32_t to, int level);
+    void pick_new_entry_point();
+
+    size_t dimension_;
+    HnswParams params_;
+    double level_multiplier_;
+    std::mt19937_64 rng_;
+    std::vector<Node> nodes_;
+    std::vector<float> vectors_;
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<uint64_t, uint32_t> slot_of_lock_;
+    uint32_t entry_point_ = 0;
+    int max_level_ = -1;
+    std::vector<uint32_t> visit_marks_;
+    uint32_t visit_epoch_ = 0;
+};
@@ -0,0 +1,274 @@
+// Implements the IVF conflict index, spherical k-means training, and the
+// centroid file format shared by dscc-ivf-train and dscc-node.
+// Pruning uses the triangle inequality on angles, so it never drops a conflict.
+
+#include "ivf_index.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+
+namespace {
+
+// Buckets are skipped only when they miss theta by more than this many
+// radians, which absorbs float error in the cosines and acos.
+constexpr double kAngleSlack = 1e-3;
+
+double angle_of(float cosine) {
+    return std::acos(std::max(-1.0, std::min(1.0, static_cast<double>(cosine))));
+}
+
+}  // namespace
+
+IvfIndex::IvfIndex(size_t dimension, std::vector<float> centroids)
+    : dimension_(dimension),
+      centroids_(std::move(centroids)) {
+    const size_t count = dimension_ == 0 ? 0 : centroids_.size() / dimension_;
+    centroids_.resize(count * dimension_);
+    for (size_t b = 0; b < count; ++b) {
+        std::vector<float> row(centroids_.begin() + b * dimension_,
+                               centroids_.begin() + (b + 1) * dimension_);
+        if (normalize_embedding(row)) {
+            std::copy(row.begin(), row.end(), centroids_.begin() + b * dimension_);
+        }
+    }
+    buckets_.resize(count);
+}
+
+void IvfIndex::insert(uint64_t lock_id, const float* centroid) {
+    if (buckets_.empty() || position_of_lock_.count(lock_id) != 0) {
+        return;
+    }
+    float cosine = 0.0f;
+    const size_t b = nearest_bucket(centroid, cosine);
+    Bucket& bucket = buckets_[b];
+    position_of_lock_.emplace(lock_id, std::make_pair(static_cast<uint32_t>(b),
+                                                      static_cast<uint32_t>(bucket.lock_ids.size())));
+    bucket.lock_ids.push_back(lock_id);
+    bucket.centroid_cosines.push_back(cosine);
+    bucket.min_cosine = std::min(bucket.min_cosine, cosine);
+}
+
+void IvfIndex::remove(uint64_t lock_id) {
+    auto it = position_of_lock_.find(lock_id);
+    if (it == position_of_lock_.end()) {
+        return;
+    }
+    Bucket& bucket = buckets_[it->second.first];
+    const size_t index = it->second.second;
+    const float removed_cosine = bucket.centroid_cosines[index];
+    position_of_lock_.erase(it);
+
+    const size_t last = bucket.lock_ids.size() - 1;
+    if (index != last) {
+        bucket.lock_ids[index] = bucket.lock_ids[last];
+        bucket.centroid_cosines[index] = bucket.centroid_cosines[last];
+        position_of_lock_[bucket.lock_ids[index]].second = static_cast<uint32_t>(index);
+    }
+    bucket.lock_ids.pop_back();
+    bucket.centroid_cosines.pop_back();
+    if (removed_cosine <= bucket.min_cosine) {
+        refresh_radius(bucket);
+    }
+}
+
+void IvfIndex::candidates(const float* query,
+                          float threshold,
+                          std::vector<uint64_t>& out) {
+    const double reach = angle_of(threshold) + kAngleSlack;
+    for (size_t b = 0; b < buckets_.size(); ++b) {
+        const Bucket& bucket = buckets_[b];
+        if (bucket.lock_ids.empty()) {
+            continue;
+        }
+        const float cosine = dot_product(query, centroids_.data() + b * dimension_, dimension_);
+        if (angle_of(cosine) - angle_of(bucket.min_cosine) > reach) {
+            continue;
+        }
+        out.insert(out.end(), bucket.lock_ids.begin(), bucket.lock_ids.end());
+    }
+}
+
+size_t IvfIndex::nearest_bucket(const float* vector, float& cosine) const {
+    size_t best = 0;
+    cosine = -std::numeric_limits<float>::infinity();
+    for (size_t b = 0; b < buckets_.size(); ++b) {
+        const float c = dot_product(vector, centroids_.data() + b * dimension_, dimension_);
+        if (c > cosine) {
+            cosine = c;
+            best = b;
+        }
+    }
+    return best;
+}
+
+void IvfIndex::refresh_radius(Bucket& bucket) {
+    bucket.min_cosine = 1.0f;
+    for (const float cosine : bucket.centroid_cosines) {
+        bucket.min_cosine = std::min(bucket.min_cosine, cosine);
+    }
+}
+
+std::vector<float> train_ivf_centroids(const std::vector<float>& samples,
+                                       size_t dimension,
+                                       size_t buckets,
+                                       size_t iterations,
+                                       uint64_t seed) {
+    if (dimension == 0) {
+        return {};
+    }
+
+    std::vector<float> points;
+    points.reserve(samples.size());
+    for (size_t offset = 0; offset + dimension <= samples.size(); offset += dimension) {
+        std::vector<float> row(samples.begin() + offset, samples.begin() + offset + dimension);
+        if (normalize_embedding(row)) {
+            points.insert(points.end(), row.begin(), row.end());
+        }
+    }
+    const size_t count = points.size() / dimension;
+    buckets = std::min(buckets, count);
+    if (buckets == 0) {
+        return {};
+    }
+    const auto point = [&](size_t i) { return points.data() + i * dimension; };
+
+    // k-means++ seeding with 1 - cosine as the distance.
+    std::mt19937_64 rng(seed);
+    std::vector<float> centroids;
+    centroids.reserve(buckets * dimension);
+    const size_t first = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    centroids.insert(centroids.end(), point(first), point(first) + dimension);
+    std::vector<double> distance(count, std::numeric_limits<double>::max());
+    for (size_t b = 1; b < buckets; ++b) {
+        const float* latest = centroids.data() + (b - 1) * dimension;
+        double total = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            const double d = std::max(0.0, 1.0 - dot_product(point(i), latest, dimension));
+            distance[i] = std::min(distance[i], d);
+            total += distance[i];
+        }
+        size_t chosen = 0;
+        if (total > 0.0) {
+            double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+            for (; chosen + 1 < count; ++chosen) {
+                target -= distance[chosen];
+                if (target <= 0.0) {
+                    break;
+                }
+            }
+        }
+        centroids.insert(centroids.end(), point(chosen), point(chosen) + dimension);
+    }
+
+    std::vector<size_t> assignment(count, 0);
+    std::vector<float> best_cosine(count, 0.0f);
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+        bool changed = iteration == 0;
+        for (size_t i = 0; i < count; ++i) {
+            size_t best = 0;
+            float best_value = -std::numeric_limits<float>::infinity();
+            for (size_t b = 0; b < buckets; ++b) {
+                const float c = dot_product(point(i), centroids.data() + b * dimension, dimension);
+                if (c > best_value) {
+                    best_value = c;
+                    best = b;
+                }
+            }
+            changed = changed || assignment[i] != best;
+            assignment[i] = best;
+            best_cosine[i] = best_value;
+        }
+        if (!changed) {
+            break;
+        }
+
+        std::vector<double> sums(buckets * dimension, 0.0);
+        std::vector<size_t> members(buckets, 0);
+        for (size_t i = 0; i < count; ++i) {
+            double* sum = sums.data() + assignment[i] * dimension;
+            for (size_t d = 0; d < dimension; ++d) {
+                sum[d] += point(i)[d];
+            }
+            ++members[assignment[i]];
+        }
+        for (size_t b = 0; b < buckets; ++b) {
+            std::vector<float> row(dimension);
+            bool valid = members[b] > 0;
+            if (valid) {
+                for (size_t d = 0; d < dimension; ++d) {
+                    row[d] = static_cast<float>(sums[b * dimension + d]);
+                }
+                valid = normalize_embedding(row);
+            }
+            if (!valid) {
+                // Re-seed an empty bucket with the worst-served point.
+                const size_t worst = static_cast<size_t>(
+                    std::min_element(best_cosine.begin(), best_cosine.end()) - best_cosine.begin());
+                row.assign(point(worst), point(worst) + dimension);
+                best_cosine[worst] = 1.0f;
+            }
+            std::copy(row.begin(), row.end(), centroids.begin() + b * dimension);
+        }
+    }
+    return centroids;
+}
+
+bool save_ivf_centroids(const std::string& path,
+                        const std::vector<float>& centroids,
+                        size_t dimension,
+                        std::string& error) {
+    if (dimension == 0 || centroids.empty() || centroids.size() % dimension != 0) {
+        error = "no centroids to write";
+        return false;
+    }
+    std::ofstream file(path);
+    if (!file) {
+        error = "could not open " + path + " for writing";
+        return false;
+    }
+    const size_t buckets = centroids.size() / dimension;
+    file << "dscc-ivf " << buckets << " " << dimension << "\n";
+    file << std::setprecision(9);
+    for (size_t b = 0; b < buckets; ++b) {
+        for (size_t d = 0; d < dimension; ++d) {
+            file << (d > 0 ? " " : "") << centroids[b * dimension + d];
+        }
+        file << "\n";
+    }
+    if (!file) {
+        error = "write to " + path + " failed";
+        return false;
+    }
+    return true;
+}
+
+bool load_ivf_centroids(const std::string& path,
+                        std::vector<float>& centroids,
+                        size_t& dimension,
+                        std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "could not open " + path;
+        return false;
+    }
+    std::string magic;
+    size_t buckets = 0;
+    file >> magic >> buckets >> dimension;
+    if (!file || magic != "dscc-ivf" || buckets == 0 || dimension == 0) {
+        error = path + " is not a dscc-ivf centroid file";
+        return false;
+    }
+    centroids.assign(buckets * dimension, 0.0f);
+    for (float& value : centroids) {
+        if (!(file >> value)) {
+            error = path + " ended before " + std::to_string(buckets) + " rows were read";
+            return false;
+        }
+    }
+    return true;
+}
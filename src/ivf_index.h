@@ -0,0 +1,74 @@
+// Declares the inverted-file (IVF) conflict index and its offline trainer.
+// Coarse centroids come from dscc-ivf-train; each active lock is filed under
+// its nearest centroid, and a query skips every bucket that cannot reach theta.
+
+#pragma once
+
+#include "conflict_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class IvfIndex final : public ConflictIndex {
+public:
+    // `centroids` holds bucket_count rows of `dimension` floats; rows are
+    // normalized here, so the trainer output can be passed straight in.
+    IvfIndex(size_t dimension, std::vector<float> centroids);
+
+    void insert(uint64_t lock_id, const float* centroid) override;
+
+    void remove(uint64_t lock_id) override;
+
+    // Exact: a bucket is skipped only when the angle from the query to its
+    // centroid, minus the bucket's angular radius, exceeds arccos(threshold).
+    void candidates(const float* query,
+                    float threshold,
+                    std::vector<uint64_t>& out) override;
+
+    size_t size() const override { return position_of_lock_.size(); }
+
+    size_t bucket_count() const { return buckets_.size(); }
+
+private:
+    struct Bucket {
+        std::vector<uint64_t> lock_ids;
+        // Cosine between each member and the bucket centroid.
+        std::vector<float> centroid_cosines;
+        // Smallest of centroid_cosines: the bucket's angular radius as a cosine.
+        float min_cosine = 1.0f;
+    };
+
+    size_t nearest_bucket(const float* vector, float& cosine) const;
+    void refresh_radius(Bucket& bucket);
+
+    size_t dimension_;
+    std::vector<float> centroids_;
+    std::vector<Bucket> buckets_;
+    // lock id -> (bucket, position inside the bucket)
+    std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> position_of_lock_;
+};
+
+// Spherical k-means over `samples` (row-major, `dimension` floats per row).
+// Rows that cannot be normalized are skipped. Returns bucket-major unit
+// centroids; fewer than `buckets` rows if the sample is smaller than that.
+std::vector<float> train_ivf_centroids(const std::vector<float>& samples,
+                                       size_t dimension,
+                                       size_t buckets,
+                                       size_t iterations,
+                                       uint64_t seed);
+
+// Plain-text centroid file: a "dscc-ivf <buckets> <dimension>" header line
+// followed by one whitespace-separated row per bucket.
+bool save_ivf_centroids(const std::string& path,
+                        const std::vector<float>& centroids,
+                        size_t dimension,
+                        std::string& error);
+
+bool load_ivf_centroids(const std::string& path,
+                        std::vector<float>& centroids,
+                        size_t& dimension,
+                        std::string& error);
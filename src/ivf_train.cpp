@@ -0,0 +1,235 @@
+// Trains the coarse centroids that dscc-node loads for CONFLICT_INDEX=ivf and
+// LOCK_SHARD_CENTROIDS.
+// It scrolls a Qdrant collection over the same HTTP path dscc-node uses for
+// upserts, keeps a uniform random sample of its vectors, then runs spherical
+// k-means.
+
+#include "ivf_index.h"
+#include "qdrant_http.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TrainConfig {
+    std::string qdrant_host = "127.0.0.1";
+    std::string qdrant_port = "6333";
+    std::string collection = "dscc_memory";
+    std::string output_path = "ivf_centroids.txt";
+    size_t buckets = 64;
+    size_t sample_size = 20000;
+    size_t iterations = 25;
+};
+
+size_t read_size_or(const char* key, size_t fallback) {
+    const char* value = std::getenv(key);
+    if (value == nullptr) {
+        return fallback;
+    }
+    char* endptr = nullptr;
+    const long long parsed = std::strtoll(value, &endptr, 10);
+    return (endptr == value || parsed <= 0) ? fallback : static_cast<size_t>(parsed);
+}
+
+TrainConfig load_config() {
+    TrainConfig config;
+    if (const char* host = std::getenv("QDRANT_HOST")) {
+        config.qdrant_host = host;
+    }
+    if (const char* port = std::getenv("QDRANT_PORT")) {
+        config.qdrant_port = port;
+    }
+    if (const char* collection = std::getenv("QDRANT_COLLECTION")) {
+        config.collection = collection;
+    }
+    if (const char* output = std::getenv("IVF_CENTROIDS")) {
+        config.output_path = output;
+    }
+    config.buckets = read_size_or("IVF_BUCKETS", config.buckets);
+    config.sample_size = read_size_or("IVF_SAMPLE", config.sample_size);
+    config.iterations = read_size_or("IVF_ITERATIONS", config.iterations);
+    return config;
+}
+
+// Parses the JSON array that starts at body[pos] == '[' and returns the
+// position just past its closing bracket, or npos if it is malformed.
+size_t parse_float_array(const std::string& body, size_t pos, std::vector<float>& values) {
+    std::string token;
+    for (++pos; pos < body.size(); ++pos) {
+        const char ch = body[pos];
+        if (ch == ',' || ch == ']' || std::isspace(static_cast<unsigned char>(ch)) != 0) {
+            if (!token.empty()) {
+                char* endptr = nullptr;
+                const float value = std::strtof(token.c_str(), &endptr);
+                if (endptr == token.c_str()) {
+                    return std::string::npos;
+                }
+                values.push_back(value);
+                token.clear();
+            }
+            if (ch == ']') {
+                return pos + 1;
+            }
+            continue;
+        }
+        if (ch == '[' || ch == '{') {
+            return std::string::npos;
+        }
+        token.push_back(ch);
+    }
+    return std::string::npos;
+}
+
+// Reads the raw JSON token after "next_page_offset": a number, a quoted
+// UUID, or null (returned as an empty string).
+std::string parse_next_offset(const std::string& body) {
+    const size_t key = body.find("\"next_page_offset\"");
+    if (key == std::string::npos) {
+        return {};
+    }
+    size_t pos = body.find(':', key);
+    if (pos == std::string::npos) {
+        return {};
+    }
+    ++pos;
+    while (pos < body.size() && std::isspace(static_cast<unsigned char>(body[pos])) != 0) {
+        ++pos;
+    }
+    size_t end = pos;
+    if (end < body.size() && body[end] == '"') {
+        end = body.find('"', end + 1);
+        return end == std::string::npos ? std::string() : body.substr(pos, end - pos + 1);
+    }
+    while (end < body.size() && body[end] != ',' && body[end] != '}' &&
+           std::isspace(static_cast<unsigned char>(body[end])) == 0) {
+        ++end;
+    }
+    const std::string token = body.substr(pos, end - pos);
+    return token == "null" ? std::string() : token;
+}
+
+// Scrolls the whole collection and keeps a uniform sample of up to `wanted`
+// of its vectors in `samples` (reservoir sampling), so the centroids do not
+// lean towards the points Qdrant lists first. `seen` counts every point
+// read.
+bool sample_vectors(const TrainConfig& config,
+                    size_t wanted,
+                    size_t& dimension,
+                    std::vector<float>& samples,
+                    size_t& seen) {
+    constexpr size_t kPageSize = 1024;
+    const std::string target = "/collections/" + config.collection + "/points/scroll";
+    std::mt19937_64 rng(42);
+    std::string offset;
+    size_t collected = 0;
+    seen = 0;
+    while (true) {
+        std::ostringstream body;
+        body << "{\"limit\":" << kPageSize
+             << ",\"with_payload\":false,\"with_vector\":true";
+        if (!offset.empty()) {
+            body << ",\"offset\":" << offset;
+        }
+        body << "}";
+
+        int status_code = 0;
+        std::string response;
+        if (!send_qdrant_http_json(config.qdrant_host, config.qdrant_port, "POST", target,
+                                   body.str(), status_code, response)) {
+            return false;
+        }
+        if (status_code != 200) {
+            std::cout << "[IVF] scroll failed status=" << status_code
+                      << " response=" << response << std::endl;
+            return false;
+        }
+
+        size_t page_points = 0;
+        for (size_t pos = response.find("\"vector\""); pos != std::string::npos;
+             pos = response.find("\"vector\"", pos)) {
+            const size_t array_start = response.find_first_not_of(" \t\r\n:", pos + 8);
+            if (array_start == std::string::npos || response[array_start] != '[') {
+                std::cout << "[IVF] points must use a single unnamed vector" << std::endl;
+                return false;
+            }
+            std::vector<float> vector;
+            pos = parse_float_array(response, array_start, vector);
+            if (pos == std::string::npos || vector.empty()) {
+                std::cout << "[IVF] could not parse a point vector" << std::endl;
+                return false;
+            }
+            if (dimension == 0) {
+                dimension = vector.size();
+            }
+            if (vector.size() != dimension) {
+                std::cout << "[IVF] skipping point with dimension " << vector.size()
+                          << " (expected " << dimension << ")" << std::endl;
+                continue;
+            }
+            ++page_points;
+            ++seen;
+            if (collected < wanted) {
+                samples.insert(samples.end(), vector.begin(), vector.end());
+                ++collected;
+                continue;
+            }
+            // The seen-th point replaces a kept one with probability
+            // wanted / seen.
+            const size_t slot = std::uniform_int_distribution<size_t>(0, seen - 1)(rng);
+            if (slot < wanted) {
+                std::copy(vector.begin(), vector.end(),
+                          samples.begin() + static_cast<std::ptrdiff_t>(slot * dimension));
+            }
+        }
+
+        offset = parse_next_offset(response);
+        if (offset.empty() || page_points == 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    const TrainConfig config = load_config();
+    std::cout << "[IVF] sampling up to " << config.sample_size << " points from "
+              << config.qdrant_host << ":" << config.qdrant_port
+              << " collection=" << config.collection << std::endl;
+
+    size_t dimension = 0;
+    size_t seen = 0;
+    std::vector<float> samples;
+    if (!sample_vectors(config, config.sample_size, dimension, samples, seen)) {
+        std::cout << "[IVF] could not read vectors from Qdrant" << std::endl;
+        return 1;
+    }
+    const size_t points = dimension == 0 ? 0 : samples.size() / dimension;
+    if (points == 0) {
+        std::cout << "[IVF] collection returned no vectors; nothing to train" << std::endl;
+        return 1;
+    }
+
+    std::cout << "[IVF] training " << config.buckets << " buckets on " << points
+              << " of " << seen << " points, dimension " << dimension << std::endl;
+    const std::vector<float> centroids =
+        train_ivf_centroids(samples, dimension, config.buckets, config.iterations, 42);
+
+    std::string error;
+    if (!save_ivf_centroids(config.output_path, centroids, dimension, error)) {
+        std::cout << "[IVF] " << error << std::endl;
+        return 1;
+    }
+    std::cout << "[IVF] wrote " << centroids.size() / dimension << " centroids to "
+              << config.output_path << std::endl;
+    return 0;
+}
@@ -3,15 +3,12 @@
 // It is the server-side core that the end-to-end bench exercises.
 
 #include "lock_service_impl.h"
+#include "qdrant_http.h"
+#include "similarity_kernels.h"
 
-#include <netdb.h>
-#include <sys/socket.h>
-#include <unistd.h>
-
-#include <cerrno>
+#include <cctype>
 #include <chrono>
 #include <cstdlib>
-#include <cstring>
 #include <functional>
 #include <cstdint>
 #include <limits>
@@ -43,6 +40,15 @@ private:
     bool active_;
 };
 
+// Longest lease a caller may ask for in one AcquireGuard or RenewLease.
+constexpr int64_t kMaxLeaseTtlMs = 24LL * 60 * 60 * 1000;
+
+int64_t unix_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
 float read_theta_from_env() {
     constexpr float kDefaultTheta = 0.85f;
     const char* theta_env = std::getenv("THETA");
@@ -77,6 +83,142 @@ std::string getenv_or_default(const char* key, const char* fallback) {
     return value != nullptr ? value : fallback;
 }
 
+size_t read_size_from_env(const char* key, size_t fallback, size_t min_value, size_t max_value) {
+    const char* env = std::getenv(key);
+    if (env == nullptr) {
+        return fallback;
+    }
+
+    char* endptr = nullptr;
+    const long long parsed = std::strtoll(env, &endptr, 10);
+    if (endptr == env ||
+        parsed < static_cast<long long>(min_value) ||
+        parsed > static_cast<long long>(max_value)) {
+        return fallback;
+    }
+    return static_cast<size_t>(parsed);
+}
+
+float read_float_from_env(const char* key, float fallback, float min_value, float max_value) {
+    const char* env = std::getenv(key);
+    if (env == nullptr) {
+        return fallback;
+    }
+
+    char* endptr = nullptr;
+    const float parsed = std::strtof(env, &endptr);
+    if (endptr == env || !(parsed >= min_value && parsed <= max_value)) {
+        return fallback;
+    }
+    return parsed;
+}
+
+// Parses "similarity:holders" pairs separated by commas, e.g. "0.85:2,0.78:4".
+bool parse_concurrency_bands(const std::string& spec,
+                             std::vector<ConcurrencyBand>& bands,
+                             std::string& error) {
+    std::istringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        const char* text = entry.c_str();
+        char* endptr = nullptr;
+        ConcurrencyBand band;
+        band.min_similarity = std::strtof(text, &endptr);
+        if (endptr == text || *endptr != ':' ||
+            !(band.min_similarity >= 0.0f && band.min_similarity <= 1.0f)) {
+            error = "bad similarity in \"" + entry + "\"";
+            return false;
+        }
+        const char* holders = endptr + 1;
+        const long long parsed = std::strtoll(holders, &endptr, 10);
+        if (endptr == holders || *endptr != '\0' || parsed < 1) {
+            error = "bad holder limit in \"" + entry + "\"";
+            return false;
+        }
+        band.max_holders = static_cast<size_t>(parsed);
+        bands.push_back(band);
+    }
+    return true;
+}
+
+ActiveLockTableOptions read_lock_table_options_from_env() {
+    ActiveLockTableOptions options;
+    const std::string index_kind = getenv_or_default("CONFLICT_INDEX", "linear");
+    if (index_kind == "hnsw") {
+        options.index_kind = ConflictIndexKind::kHnsw;
+    } else if (index_kind == "ivf") {
+        const std::string path = getenv_or_default("IVF_CENTROIDS", "ivf_centroids.txt");
+        std::string error;
+        if (load_ivf_centroids(path, options.ivf_centroids, options.ivf_dimension, error)) {
+            options.index_kind = ConflictIndexKind::kIvf;
+        } else {
+            std::cout << "[LOCK] IVF index disabled: " << error << std::endl;
+        }
+    }
+    options.index_min_locks =
+        read_size_from_env("CONFLICT_INDEX_MIN_LOCKS", options.index_min_locks, 0, 100000000);
+    options.hnsw.m = read_size_from_env("HNSW_M", options.hnsw.m, 2, 128);
+    options.hnsw.ef_construction =
+        read_size_from_env("HNSW_EF_CONSTRUCTION", options.hnsw.ef_construction, 1, 4096);
+    options.hnsw.ef_search = read_size_from_env("HNSW_EF_SEARCH", options.hnsw.ef_search, 1, 4096);
+    options.quantized_prefilter = getenv_or_default("QUANTIZED_PREFILTER", "off") == "int8";
+    options.quantized_band =
+        read_float_from_env("QUANTIZED_BAND", options.quantized_band, 0.0f, 1.0f);
+    options.half_precision_centroids = getenv_or_default("CENTROID_PRECISION", "fp32") == "fp16";
+    options.half_precision_band =
+        read_float_from_env("HALF_PRECISION_BAND", options.half_precision_band, 0.0f, 1.0f);
+    options.shard_bits = read_size_from_env("LOCK_SHARD_BITS", options.shard_bits, 0, 8);
+    const std::string shard_centroids = getenv_or_default("LOCK_SHARD_CENTROIDS", "");
+    if (options.shard_bits > 0 && !shard_centroids.empty()) {
+        std::string error;
+        if (!load_ivf_centroids(shard_centroids, options.shard_centroids,
+                                options.shard_centroid_dimension, error)) {
+            std::cout << "[LOCK] trained shard placement disabled: " << error << std::endl;
+            options.shard_centroids.clear();
+            options.shard_centroid_dimension = 0;
+        }
+    }
+    const std::string queue_policy = getenv_or_default("QUEUE_POLICY", "overtake");
+    if (queue_policy == "fifo") {
+        options.queue_policy = QueuePolicy::kFifo;
+    } else if (queue_policy == "bypass") {
+        options.queue_policy = QueuePolicy::kBoundedBypass;
+    }
+    options.max_bypass = read_size_from_env("QUEUE_MAX_BYPASS", options.max_bypass, 0, 1000000);
+    options.writer_preference = getenv_or_default("WRITER_PREFERENCE", "on") != "off";
+    const std::string bands = getenv_or_default("CONCURRENCY_BANDS", "");
+    std::string bands_error;
+    if (!bands.empty() &&
+        !parse_concurrency_bands(bands, options.concurrency_bands, bands_error)) {
+        options.concurrency_bands.clear();
+        std::cout << "[LOCK] concurrency bands disabled: " << bands_error << std::endl;
+    }
+    options.pivot_count = read_size_from_env("PIVOT_COUNT", options.pivot_count, 0, 64);
+    options.cluster_similarity =
+        read_float_from_env("CLUSTER_SIMILARITY", options.cluster_similarity, 0.0f, 1.0f);
+    options.parallel_scan_threads =
+        read_size_from_env("PARALLEL_SCAN_THREADS", options.parallel_scan_threads, 0, 256);
+    options.parallel_scan_min_locks = read_size_from_env(
+        "PARALLEL_SCAN_MIN_LOCKS", options.parallel_scan_min_locks, 1, 100000000);
+    options.lease_tick = std::chrono::milliseconds(read_size_from_env(
+        "LEASE_TICK_MS", static_cast<size_t>(options.lease_tick.count()), 1, 60000));
+    options.deadline_slack = std::chrono::milliseconds(read_size_from_env(
+        "DEADLINE_SLACK_MS", static_cast<size_t>(options.deadline_slack.count()), 0, 600000));
+    return options;
+}
+
+// Maps the client deadline onto the lock table's steady clock. Calls without
+// a deadline report the system clock's maximum.
+ActiveLockTable::Clock::time_point lock_deadline(const grpc::ServerContext& context) {
+    const auto deadline = context.deadline();
+    if (deadline == std::chrono::system_clock::time_point::max()) {
+        return ActiveLockTable::Clock::time_point::max();
+    }
+    return ActiveLockTable::Clock::now() +
+           std::chrono::duration_cast<ActiveLockTable::Clock::duration>(
+               deadline - std::chrono::system_clock::now());
+}
+
 int64_t make_numeric_point_id(const std::string& agent_id, int64_t timestamp_unix_ms) {
     constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
     constexpr uint64_t kFnvPrime = 1099511628211ULL;
@@ -126,25 +268,11 @@ std::string escape_json(const std::string& input) {
     return output;
 }
 
-bool send_all(int socket_fd, const std::string& payload) {
-    size_t total_sent = 0;
-    while (total_sent < payload.size()) {
-        const ssize_t sent = ::send(socket_fd,
-                                    payload.data() + total_sent,
-                                    payload.size() - total_sent,
-                                    0);
-        if (sent <= 0) {
-            return false;
-        }
-        total_sent += static_cast<size_t>(sent);
-    }
-    return true;
-}
-
 }  // namespace
 
 LockServiceImpl::LockServiceImpl()
-    : theta_(read_theta_from_env()),
+    : lock_table_(read_lock_table_options_from_env()),
+      theta_(read_theta_from_env()),
       lock_hold_ms_(read_lock_hold_ms_from_env()),
       qdrant_host_(getenv_or_default("QDRANT_HOST", "qdrant")),
       qdrant_port_(getenv_or_default("QDRANT_PORT", "6333")),
@@ -160,52 +288,119 @@ grpc::Status LockServiceImpl::Ping(
 }
 
 grpc::Status LockServiceImpl::AcquireGuard(
-    grpc::ServerContext*,
+    grpc::ServerContext* context,
     const dscc::AcquireRequest* request,
     dscc::AcquireResponse* response) {
     const std::string agent_id = request->agent_id();
-    const std::vector<float> embedding(request->embedding().begin(),
-                                       request->embedding().end());
+    // `embeddings`, when given, replaces the single `embedding`.
+    std::vector<std::vector<float>> embeddings;
+    if (request->embeddings_size() > 0) {
+        for (const dscc::Embedding& entry : request->embeddings()) {
+            embeddings.emplace_back(entry.values().begin(), entry.values().end());
+        }
+    } else {
+        embeddings.emplace_back(request->embedding().begin(), request->embedding().end());
+    }
     const std::string payload_text = request->payload_text();
     const std::string source_file = request->source_file();
-    const auto now_ms = []() -> int64_t {
-        return std::chrono::duration_cast<std::chrono::milliseconds>(
-                   std::chrono::system_clock::now().time_since_epoch())
-            .count();
-    };
     const int64_t timestamp_unix_ms =
-        request->timestamp_unix_ms() > 0 ? request->timestamp_unix_ms() : now_ms();
-    const int64_t point_id = make_numeric_point_id(agent_id, timestamp_unix_ms);
-    const int64_t server_received_unix_ms = now_ms();
+        request->timestamp_unix_ms() > 0 ? request->timestamp_unix_ms() : unix_now_ms();
+    const int64_t server_received_unix_ms = unix_now_ms();
 
     if (agent_id.empty()) {
         response->set_granted(false);
         response->set_message("agent_id is required");
         return grpc::Status::OK;
     }
-    if (embedding.empty()) {
-        response->set_granted(false);
-        response->set_message("embedding is required");
-        return grpc::Status::OK;
+    std::vector<std::vector<float>> unit_embeddings = embeddings;
+    for (std::vector<float>& unit_embedding : unit_embeddings) {
+        if (unit_embedding.empty()) {
+            response->set_granted(false);
+            response->set_message("embedding is required");
+            return grpc::Status::OK;
+        }
+        if (!normalize_embedding(unit_embedding)) {
+            response->set_granted(false);
+            response->set_message("embedding must be finite and non-zero");
+            return grpc::Status::OK;
+        }
     }
 
     std::cout << "[TX " << agent_id << "] attempting acquire" << std::endl;
     response->set_server_received_unix_ms(server_received_unix_ms);
-    const AcquireTrace acquire_trace = lock_table_.acquire(agent_id, embedding, theta_);
-    const int64_t lock_acquired_unix_ms = now_ms();
+    const bool diagnostics = !request->omit_blocker_diagnostics();
+    const bool shared = request->mode() == dscc::LOCK_MODE_SHARED;
+    // A call without a lease holds its lock for LOCK_HOLD_MS before it
+    // answers, so it has to be granted that much before the client's
+    // deadline. A leased call answers right after the grant.
+    ActiveLockTable::Clock::time_point deadline = lock_deadline(*context);
+    if (request->lease_ttl_ms() <= 0 && deadline != ActiveLockTable::Clock::time_point::max()) {
+        deadline -= std::chrono::milliseconds(lock_hold_ms_);
+    }
+    // Several embeddings are locked all or nothing in one table pass.
+    const AcquireTrace acquire_trace = lock_table_.acquire_all_until(
+        agent_id, unit_embeddings, theta_, deadline,
+        [context]() { return context->IsCancelled(); }, diagnostics,
+        shared ? LockMode::kShared : LockMode::kExclusive);
+    if (acquire_trace.status == AcquireStatus::kDimensionMismatch) {
+        size_t mismatched = unit_embeddings.front().size();
+        for (const std::vector<float>& unit_embedding : unit_embeddings) {
+            if (unit_embedding.size() != acquire_trace.table_dimension) {
+                mismatched = unit_embedding.size();
+                break;
+            }
+        }
+        response->set_granted(false);
+        response->set_message("embedding has " + std::to_string(mismatched) +
+                              " dimensions but the lock table is fixed at " +
+                              std::to_string(acquire_trace.table_dimension));
+        return grpc::Status::OK;
+    }
+    if (acquire_trace.status == AcquireStatus::kDeadlineExceeded) {
+        std::cout << "[TX " << agent_id << "] gave up: deadline cannot be met" << std::endl;
+        return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED,
+                            "semantic lock could not be granted before the deadline");
+    }
+    if (acquire_trace.status == AcquireStatus::kCancelled) {
+        std::cout << "[TX " << agent_id << "] gave up: client cancelled" << std::endl;
+        return grpc::Status(grpc::StatusCode::CANCELLED, "client cancelled while waiting for the lock");
+    }
+    const int64_t lock_acquired_unix_ms = unix_now_ms();
     response->set_lock_acquired_unix_ms(lock_acquired_unix_ms);
     response->set_lock_wait_ms(lock_acquired_unix_ms - server_received_unix_ms);
-    response->set_blocking_similarity_score(acquire_trace.blocking_similarity_score);
-    if (!acquire_trace.blocking_agent_id.empty()) {
-        response->set_blocking_agent_id(acquire_trace.blocking_agent_id);
+    response->set_queue_position(static_cast<int32_t>(acquire_trace.queue_position));
+    // Without diagnostics the trace names the first conflict found, not the
+    // strongest, so it is not reported as the blocker.
+    if (diagnostics) {
+        response->set_blocking_similarity_score(acquire_trace.blocking_similarity_score);
+        if (!acquire_trace.blocking_agent_id.empty()) {
+            response->set_blocking_agent_id(acquire_trace.blocking_agent_id);
+        }
     }
-    std::cout << "[TX " << agent_id << "] acquired lock (active count = "
-              << lock_table_.size() << ")" << std::endl;
+    std::ostringstream acquired;
+    acquired << "[TX " << agent_id << "] acquired " << (shared ? "shared " : "")
+             << "lock (active count = "
+             << lock_table_.size() << ")";
+    const PivotPruningStats pruning = lock_table_.pivot_pruning_stats();
+    if (pruning.rows_considered > 0) {
+        acquired << " pivot_pruned=" << std::fixed << std::setprecision(1)
+                 << 100.0 * static_cast<double>(pruning.rows_pruned) /
+                        static_cast<double>(pruning.rows_considered)
+                 << "% of " << pruning.rows_considered << " rows";
+    }
+    const ClusterScanStats clusters = lock_table_.cluster_scan_stats();
+    if (clusters.caps_checked > 0) {
+        acquired << " cluster_skipped=" << clusters.rows_skipped << " rows over "
+                 << clusters.caps_checked << " caps";
+    }
+    std::cout << acquired.str() << std::endl;
 
     bool released = false;
     auto release_once = [&]() {
         if (!released) {
-            lock_table_.release(agent_id);
+            // Only this call's locks: a lease the agent holds from an
+            // earlier call outlives it.
+            lock_table_.release(agent_id, acquire_trace.lock_ids);
             released = true;
             std::cout << "[TX " << agent_id << "] released lock (active count = "
                       << lock_table_.size() << ")" << std::endl;
@@ -213,18 +408,52 @@ grpc::Status LockServiceImpl::AcquireGuard(
     };
     ScopeExit release_guard(release_once);
 
-    const bool qdrant_ok = upsert_embedding_to_qdrant(point_id,
-                                                      agent_id,
-                                                      payload_text,
-                                                      source_file,
-                                                      timestamp_unix_ms,
-                                                      embedding);
-    if (!qdrant_ok) {
-        response->set_granted(false);
-        response->set_message("qdrant write failed");
+    // A shared guard covers a read of the region, so there is nothing to
+    // write. Otherwise the payload is stored once per embedding; the first
+    // keeps the single-embedding point id.
+    if (!shared) {
+        for (size_t i = 0; i < embeddings.size(); ++i) {
+            const int64_t point_id = make_numeric_point_id(
+                i == 0 ? agent_id : agent_id + "#" + std::to_string(i), timestamp_unix_ms);
+            const bool qdrant_ok = upsert_embedding_to_qdrant(point_id,
+                                                              agent_id,
+                                                              payload_text,
+                                                              source_file,
+                                                              timestamp_unix_ms,
+                                                              embeddings[i]);
+            if (!qdrant_ok) {
+                response->set_granted(false);
+                response->set_message("qdrant write failed");
+                return grpc::Status::OK;
+            }
+        }
+        response->set_qdrant_write_complete_unix_ms(unix_now_ms());
+    }
+
+    // A leased lock stays with the agent after the call, until ReleaseGuard
+    // or until the lease runs out without a RenewLease. Only this call's
+    // locks go on the lease.
+    const int64_t lease_ttl_ms = std::min(request->lease_ttl_ms(), kMaxLeaseTtlMs);
+    if (lease_ttl_ms > 0) {
+        // A ReleaseGuard for the agent during the write may already have
+        // released them; the caller must not think it holds them.
+        if (!lock_table_.lease_locks(agent_id, acquire_trace.lock_ids,
+                                     std::chrono::milliseconds(lease_ttl_ms))) {
+            std::cout << "[TX " << agent_id << "] lease not established: lock already released"
+                      << std::endl;
+            response->set_granted(false);
+            response->set_message("lease not established: lock already released");
+            return grpc::Status::OK;
+        }
+        release_guard.dismiss();
+        std::cout << "[TX " << agent_id << "] holding lock under a " << lease_ttl_ms
+                  << " ms lease" << std::endl;
+        response->set_lease_expires_unix_ms(unix_now_ms() + lease_ttl_ms);
+        response->set_granted(true);
+        response->set_message(shared ? "granted shared under lease"
+                                     : "granted and committed under lease");
         return grpc::Status::OK;
     }
-    response->set_qdrant_write_complete_unix_ms(now_ms());
 
     if (lock_hold_ms_ > 0) {
         std::this_thread::sleep_for(std::chrono::milliseconds(lock_hold_ms_));
@@ -233,9 +462,9 @@ grpc::Status LockServiceImpl::AcquireGuard(
     release_once();
     release_guard.dismiss();
 
-    response->set_lock_released_unix_ms(now_ms());
+    response->set_lock_released_unix_ms(unix_now_ms());
     response->set_granted(true);
-    response->set_message("granted and committed");
+    response->set_message(shared ? "granted shared" : "granted and committed");
     return grpc::Status::OK;
 }
 
@@ -256,6 +485,28 @@ grpc::Status LockServiceImpl::ReleaseGuard(
     return grpc::Status::OK;
 }
 
+grpc::Status LockServiceImpl::RenewLease(
+    grpc::ServerContext*,
+    const dscc::RenewLeaseRequest* request,
+    dscc::RenewLeaseResponse* response) {
+    const std::string agent_id = request->agent_id();
+    const int64_t lease_ttl_ms = std::min(request->lease_ttl_ms(), kMaxLeaseTtlMs);
+    if (agent_id.empty() || lease_ttl_ms <= 0) {
+        response->set_renewed(false);
+        return grpc::Status::OK;
+    }
+
+    const bool renewed =
+        lock_table_.renew_lease(agent_id, std::chrono::milliseconds(lease_ttl_ms));
+    response->set_renewed(renewed);
+    if (renewed) {
+        response->set_lease_expires_unix_ms(unix_now_ms() + lease_ttl_ms);
+    } else {
+        std::cout << "[TX " << agent_id << "] lease not renewed: no lock held" << std::endl;
+    }
+    return grpc::Status::OK;
+}
+
 bool LockServiceImpl::upsert_embedding_to_qdrant(
     int64_t point_id,
     const std::string& agent_id,
@@ -367,81 +618,6 @@ bool LockServiceImpl::send_http_json(const std::string& method,
                                      const std::string& body,
                                      int& status_code,
                                      std::string& response_body) const {
-    status_code = 0;
-    response_body.clear();
-
-    struct addrinfo hints {};
-    hints.ai_family = AF_UNSPEC;
-    hints.ai_socktype = SOCK_STREAM;
-
-    struct addrinfo* addresses = nullptr;
-    const int address_result = ::getaddrinfo(qdrant_host_.c_str(),
-                                             qdrant_port_.c_str(),
-                                             &hints,
-                                             &addresses);
-    if (address_result != 0) {
-        std::cout << "[QDRANT] DNS resolution failed for host=" << qdrant_host_
-                  << " error=" << ::gai_strerror(address_result) << std::endl;
-        return false;
-    }
-
-    int socket_fd = -1;
-    for (struct addrinfo* addr = addresses; addr != nullptr; addr = addr->ai_next) {
-        socket_fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-        if (socket_fd < 0) {
-            continue;
-        }
-        if (::connect(socket_fd, addr->ai_addr, addr->ai_addrlen) == 0) {
-            break;
-        }
-        ::close(socket_fd);
-        socket_fd = -1;
-    }
-    ::freeaddrinfo(addresses);
-
-    if (socket_fd < 0) {
-        std::cout << "[QDRANT] connect failed host=" << qdrant_host_
-                  << " port=" << qdrant_port_
-                  << " errno=" << errno
-                  << " message=" << std::strerror(errno) << std::endl;
-        return false;
-    }
-
-    std::ostringstream request;
-    request << method << " " << target << " HTTP/1.1\r\n";
-    request << "Host: " << qdrant_host_ << ":" << qdrant_port_ << "\r\n";
-    request << "Content-Type: application/json\r\n";
-    request << "Connection: close\r\n";
-    request << "Content-Length: " << body.size() << "\r\n\r\n";
-    request << body;
-
-    const std::string payload = request.str();
-    if (!send_all(socket_fd, payload)) {
-        std::cout << "[QDRANT] send failed errno=" << errno
-                  << " message=" << std::strerror(errno) << std::endl;
-        ::close(socket_fd);
-        return false;
-    }
-
-    constexpr size_t kBufferSize = 4096;
-    char buffer[kBufferSize];
-    for (;;) {
-        const ssize_t read_count = ::recv(socket_fd, buffer, kBufferSize, 0);
-        if (read_count < 0) {
-            std::cout << "[QDRANT] recv failed errno=" << errno
-                      << " message=" << std::strerror(errno) << std::endl;
-            ::close(socket_fd);
-            return false;
-        }
-        if (read_count == 0) {
-            break;
-        }
-        response_body.append(buffer, static_cast<size_t>(read_count));
-    }
-    ::close(socket_fd);
-
-    std::istringstream response_stream(response_body);
-    std::string http_version;
-    response_stream >> http_version >> status_code;
-    return !http_version.empty() && status_code > 0;
+    return send_qdrant_http_json(qdrant_host_, qdrant_port_, method, target, body,
+                                 status_code, response_body);
 }
@@ -29,6 +29,10 @@ public:
                               const dscc::ReleaseRequest* request,
                               dscc::ReleaseResponse* response) override;
 
+    grpc::Status RenewLease(grpc::ServerContext* context,
+                            const dscc::RenewLeaseRequest* request,
+                            dscc::RenewLeaseResponse* response) override;
+
 private:
     bool upsert_embedding_to_qdrant(int64_t point_id,
                                     const std::string& agent_id,
@@ -4,6 +4,7 @@
 
 #include <grpcpp/grpcpp.h>
 #include "lock_service_impl.h"
+#include "similarity_kernels.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -21,6 +22,7 @@ int main() {
 
     std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
     std::cout << "Server listening on " << server_address << std::endl;
+    std::cout << "Similarity kernel: " << simd_level_name(active_simd_level()) << std::endl;
 
     server->Wait();
     return 0;
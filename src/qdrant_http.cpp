@@ -0,0 +1,119 @@
+// Implements the minimal HTTP/1.1 JSON client used to talk to Qdrant.
+// dscc-node and dscc-ivf-train both go through this one socket path, so
+// connection handling and error logging stay identical between them.
+
+#include "qdrant_http.h"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+bool send_all(int socket_fd, const std::string& payload) {
+    size_t total_sent = 0;
+    while (total_sent < payload.size()) {
+        const ssize_t sent = ::send(socket_fd,
+                                    payload.data() + total_sent,
+                                    payload.size() - total_sent,
+                                    0);
+        if (sent <= 0) {
+            return false;
+        }
+        total_sent += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool send_qdrant_http_json(const std::string& host,
+                           const std::string& port,
+                           const std::string& method,
+                           const std::string& target,
+                           const std::string& body,
+                           int& status_code,
+                           std::string& response_body) {
+    status_code = 0;
+    response_body.clear();
+
+    struct addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* addresses = nullptr;
+    const int address_result = ::getaddrinfo(host.c_str(),
+                                             port.c_str(),
+                                             &hints,
+                                             &addresses);
+    if (address_result != 0) {
+        std::cout << "[QDRANT] DNS resolution failed for host=" << host
+                  << " error=" << ::gai_strerror(address_result) << std::endl;
+        return false;
+    }
+
+    int socket_fd = -1;
+    for (struct addrinfo* addr = addresses; addr != nullptr; addr = addr->ai_next) {
+        socket_fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (socket_fd < 0) {
+            continue;
+        }
+        if (::connect(socket_fd, addr->ai_addr, addr->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(socket_fd);
+        socket_fd = -1;
+    }
+    ::freeaddrinfo(addresses);
+
+    if (socket_fd < 0) {
+        std::cout << "[QDRANT] connect failed host=" << host
+                  << " port=" << port
+                  << " errno=" << errno
+                  << " message=" << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::ostringstream request;
+    request << method << " " << target << " HTTP/1.1\r\n";
+    request << "Host: " << host << ":" << port << "\r\n";
+    request << "Content-Type: application/json\r\n";
+    request << "Connection: close\r\n";
+    request << "Content-Length: " << body.size() << "\r\n\r\n";
+    request << body;
+
+    const std::string payload = request.str();
+    if (!send_all(socket_fd, payload)) {
+        std::cout << "[QDRANT] send failed errno=" << errno
+                  << " message=" << std::strerror(errno) << std::endl;
+        ::close(socket_fd);
+        return false;
+    }
+
+    constexpr size_t kBufferSize = 4096;
+    char buffer[kBufferSize];
+    for (;;) {
+        const ssize_t read_count = ::recv(socket_fd, buffer, kBufferSize, 0);
+        if (read_count < 0) {
+            std::cout << "[QDRANT] recv failed errno=" << errno
+                      << " message=" << std::strerror(errno) << std::endl;
+            ::close(socket_fd);
+            return false;
+        }
+        if (read_count == 0) {
+            break;
+        }
+        response_body.append(buffer, static_cast<size_t>(read_count));
+    }
+    ::close(socket_fd);
+
+    std::istringstream response_stream(response_body);
+    std::string http_version;
+    response_stream >> http_version >> status_code;
+    return !http_version.empty() && status_code > 0;
+}
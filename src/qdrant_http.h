@@ -0,0 +1,18 @@
+// Declares the raw-socket HTTP helper used for Qdrant REST calls.
+// LockServiceImpl uses it for collection setup and upserts, and the IVF
+// trainer uses it to scroll sample points out of a collection.
+
+#pragma once
+
+#include <string>
+
+// Sends one JSON request with `Connection: close` and reads the whole reply.
+// Returns false when the connection fails; otherwise status_code holds the
+// HTTP status and response_body the raw response, headers included.
+bool send_qdrant_http_json(const std::string& host,
+                           const std::string& port,
+                           const std::string& method,
+                           const std::string& target,
+                           const std::string& body,
+                           int& status_code,
+                           std::string& response_body);
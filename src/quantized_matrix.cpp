@@ -0,0 +1,128 @@
+// Implements int8 row quantization and the packed code matrix.
+// Error norms are accumulated in double and rounded up, so the similarity
+// bound stays an upper bound despite float rounding.
+
+#include "quantized_matrix.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace {
+
+constexpr size_t kInitialCapacity = 16;
+constexpr float kMaxCode = 127.0f;
+// Relative padding on the stored norms to cover float rounding.
+constexpr double kNormPadding = 1.0 + 1e-5;
+
+size_t round_up_to_line(size_t bytes) {
+    return ((bytes + QuantizedMatrix::kAlignment - 1) / QuantizedMatrix::kAlignment) *
+           QuantizedMatrix::kAlignment;
+}
+
+}  // namespace
+
+void quantize_row(const float* values, size_t dimension, QuantizedRow& out) {
+    float max_abs = 0.0f;
+    for (size_t i = 0; i < dimension; ++i) {
+        max_abs = std::max(max_abs, std::fabs(values[i]));
+    }
+    out.codes.resize(dimension);
+    out.scale = max_abs > 0.0f ? max_abs / kMaxCode : 0.0f;
+
+    double error = 0.0;
+    double code_norm = 0.0;
+    for (size_t i = 0; i < dimension; ++i) {
+        float code = 0.0f;
+        if (out.scale > 0.0f) {
+            code = std::max(-kMaxCode, std::min(kMaxCode, std::nearbyint(values[i] / out.scale)));
+        }
+        out.codes[i] = static_cast<int8_t>(code);
+        const double restored = static_cast<double>(code) * out.scale;
+        const double diff = static_cast<double>(values[i]) - restored;
+        error += diff * diff;
+        code_norm += restored * restored;
+    }
+    out.error_norm = static_cast<float>(std::sqrt(error) * kNormPadding);
+    out.code_norm = static_cast<float>(std::sqrt(code_norm) * kNormPadding);
+}
+
+QuantizedMatrix::QuantizedMatrix(const QuantizedMatrix& other)
+    : dimension_(other.dimension_),
+      stride_(other.stride_) {
+    if (other.size() > 0) {
+        grow(other.capacity_);
+        std::memcpy(data_.get(), other.data_.get(), other.size() * stride_);
+        scales_ = other.scales_;
+        error_norms_ = other.error_norms_;
+    }
+}
+
+QuantizedMatrix& QuantizedMatrix::operator=(const QuantizedMatrix& other) {
+    if (this != &other) {
+        QuantizedMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void QuantizedMatrix::reset(size_t dimension) {
+    data_.reset();
+    scales_.clear();
+    error_norms_.clear();
+    dimension_ = dimension;
+    stride_ = round_up_to_line(dimension);
+    capacity_ = 0;
+}
+
+size_t QuantizedMatrix::push_back(const float* values) {
+    const size_t index = size();
+    if (index == capacity_) {
+        grow(index + 1);
+    }
+    quantize_row(values, dimension_, scratch_);
+    int8_t* dest = data_.get() + index * stride_;
+    std::memcpy(dest, scratch_.codes.data(), dimension_);
+    std::fill(dest + dimension_, dest + stride_, int8_t{0});
+    scales_.push_back(scratch_.scale);
+    error_norms_.push_back(scratch_.error_norm);
+    return index;
+}
+
+void QuantizedMatrix::copy_row(size_t index, const QuantizedMatrix& source, size_t source_index) {
+    std::memcpy(data_.get() + index * stride_, source.row(source_index), stride_);
+    scales_[index] = source.scales_[source_index];
+    error_norms_[index] = source.error_norms_[source_index];
+}
+
+size_t QuantizedMatrix::swap_remove(size_t index) {
+    const size_t last = size() - 1;
+    if (index != last) {
+        std::memcpy(data_.get() + index * stride_, data_.get() + last * stride_, stride_);
+        scales_[index] = scales_[last];
+        error_norms_[index] = error_norms_[last];
+    }
+    scales_.pop_back();
+    error_norms_.pop_back();
+    return last;
+}
+
+int32_t QuantizedMatrix::dot_codes(const int8_t* query_codes, size_t index) const {
+    return dot_product_int8(query_codes, row(index), dimension_);
+}
+
+void QuantizedMatrix::grow(size_t min_capacity) {
+    const size_t new_capacity = std::max({min_capacity, kInitialCapacity, capacity_ * 2});
+    int8_t* fresh = static_cast<int8_t*>(std::aligned_alloc(kAlignment, new_capacity * stride_));
+    if (fresh == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (size() > 0) {
+        std::memcpy(fresh, data_.get(), size() * stride_);
+    }
+    data_.reset(fresh);
+    capacity_ = new_capacity;
+}
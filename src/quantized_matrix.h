@@ -0,0 +1,78 @@
+// Declares the int8 shadow copy of the active lock centroids.
+// Each row keeps its scale and the exact norm of its rounding error, which
+// turns a cheap integer dot product into a guaranteed upper bound on similarity.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Symmetric per-row quantization: value ~= code * scale, scale = max|x| / 127.
+struct QuantizedRow {
+    std::vector<int8_t> codes;
+    float scale = 0.0f;
+    // ||x - codes * scale||, the exact rounding error of the row.
+    float error_norm = 0.0f;
+    // ||codes * scale||, the norm of the reconstructed row.
+    float code_norm = 0.0f;
+};
+
+void quantize_row(const float* values, size_t dimension, QuantizedRow& out);
+
+class QuantizedMatrix {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    QuantizedMatrix() = default;
+    QuantizedMatrix(const QuantizedMatrix& other);
+    QuantizedMatrix& operator=(const QuantizedMatrix& other);
+    QuantizedMatrix(QuantizedMatrix&&) = default;
+    QuantizedMatrix& operator=(QuantizedMatrix&&) = default;
+
+    void reset(size_t dimension);
+
+    size_t dimension() const { return dimension_; }
+    size_t size() const { return scales_.size(); }
+
+    const int8_t* row(size_t index) const { return data_.get() + index * stride_; }
+    float scale(size_t index) const { return scales_[index]; }
+    float error_norm(size_t index) const { return error_norms_[index]; }
+
+    // Quantizes a row of dimension() floats and appends it; returns its index.
+    size_t push_back(const float* values);
+
+    // Overwrites row `index` with row `source_index` of `source`, which must
+    // have the same dimension; the codes are copied, not requantized.
+    void copy_row(size_t index, const QuantizedMatrix& source, size_t source_index);
+
+    // Mirrors CentroidMatrix::swap_remove so row indices stay in step.
+    size_t swap_remove(size_t index);
+
+    // Upper bound on dot(query, row) for a unit-length row:
+    //   q.x = q~.x~ + (q - q~).x + q~.(x - x~)
+    //      <= q~.x~ + ||q - q~|| + ||q~|| * ||x - x~||
+    float similarity_upper_bound(const QuantizedRow& query, size_t index) const {
+        const float estimate = static_cast<float>(dot_codes(query.codes.data(), index)) *
+                               query.scale * scales_[index];
+        return estimate + query.error_norm + query.code_norm * error_norms_[index];
+    }
+
+private:
+    struct AlignedFree {
+        void operator()(int8_t* ptr) const { std::free(ptr); }
+    };
+
+    int32_t dot_codes(const int8_t* query_codes, size_t index) const;
+    void grow(size_t min_capacity);
+
+    std::unique_ptr<int8_t[], AlignedFree> data_;
+    std::vector<float> scales_;
+    std::vector<float> error_norms_;
+    QuantizedRow scratch_;
+    size_t dimension_ = 0;
+    size_t stride_ = 0;
+    size_t capacity_ = 0;
+};
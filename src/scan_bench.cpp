@@ -0,0 +1,222 @@
+// Measures conflict-scan throughput over fp32 and fp16 centroid rows.
+// The same clustered unit embeddings are scanned in both layouts, and every
+// fp16 decision at theta is compared with the fp32 one, with and without the
+// re-verification band that CENTROID_PRECISION=fp16 uses in dscc-node.
+
+#include "centroid_matrix.h"
+#include "half_matrix.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct BenchConfig {
+    size_t locks = 100000;
+    size_t dimension = 384;
+    size_t queries = 32;
+    size_t topics = 64;
+    size_t repeats = 3;
+    float theta = 0.85f;
+    float band = 1e-3f;
+};
+
+size_t read_size_or(const char* key, size_t fallback) {
+    const char* value = std::getenv(key);
+    if (value == nullptr) {
+        return fallback;
+    }
+    char* endptr = nullptr;
+    const long long parsed = std::strtoll(value, &endptr, 10);
+    return (endptr == value || parsed <= 0) ? fallback : static_cast<size_t>(parsed);
+}
+
+float read_float_or(const char* key, float fallback) {
+    const char* value = std::getenv(key);
+    if (value == nullptr) {
+        return fallback;
+    }
+    char* endptr = nullptr;
+    const float parsed = std::strtof(value, &endptr);
+    return (endptr == value || !(parsed >= 0.0f && parsed <= 1.0f)) ? fallback : parsed;
+}
+
+BenchConfig load_config() {
+    BenchConfig config;
+    config.locks = read_size_or("SCAN_BENCH_LOCKS", config.locks);
+    config.dimension = read_size_or("SCAN_BENCH_DIM", config.dimension);
+    config.queries = read_size_or("SCAN_BENCH_QUERIES", config.queries);
+    config.topics = read_size_or("SCAN_BENCH_TOPICS", config.topics);
+    config.repeats = read_size_or("SCAN_BENCH_REPEATS", config.repeats);
+    config.theta = read_float_or("THETA", config.theta);
+    config.band = read_float_or("HALF_PRECISION_BAND", config.band);
+    return config;
+}
+
+// Unit embeddings around random topic directions with a per-topic spread,
+// so that plenty of pairs land near theta.
+class TopicSampler {
+public:
+    TopicSampler(size_t dimension, size_t topics, std::mt19937& rng)
+        : topics_(topics, std::vector<float>(dimension)),
+          spread_(topics) {
+        std::uniform_real_distribution<float> spread(0.3f, 0.9f);
+        for (size_t t = 0; t < topics; ++t) {
+            for (float& value : topics_[t]) {
+                value = normal_(rng);
+            }
+            normalize_embedding(topics_[t]);
+            spread_[t] = spread(rng);
+        }
+    }
+
+    void sample(std::mt19937& rng, std::vector<float>& out) {
+        const size_t t = rng() % topics_.size();
+        const std::vector<float>& topic = topics_[t];
+        const float scale = spread_[t] / std::sqrt(static_cast<float>(topic.size()));
+        out.resize(topic.size());
+        for (size_t i = 0; i < topic.size(); ++i) {
+            out[i] = topic[i] + scale * normal_(rng);
+        }
+        normalize_embedding(out);
+    }
+
+private:
+    std::vector<std::vector<float>> topics_;
+    std::vector<float> spread_;
+    std::normal_distribution<float> normal_{0.0f, 1.0f};
+};
+
+struct ScanResult {
+    double seconds = 0.0;
+    size_t conflicts = 0;
+    size_t verified = 0;
+};
+
+// Best of `repeats` full scans, so page faults and frequency ramp-up on the
+// first pass do not count.
+template <typename ScanFn>
+ScanResult time_scans(size_t repeats, ScanFn scan) {
+    using Clock = std::chrono::steady_clock;
+    ScanResult best;
+    best.seconds = -1.0;
+    for (size_t r = 0; r < repeats; ++r) {
+        ScanResult result;
+        const Clock::time_point start = Clock::now();
+        scan(result);
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (best.seconds < 0.0 || result.seconds < best.seconds) {
+            best = result;
+        }
+    }
+    return best;
+}
+
+void print_throughput(const char* label,
+                      const ScanResult& result,
+                      double rows,
+                      double bytes_per_row) {
+    std::cout << "[SCAN] " << label << std::fixed << std::setprecision(1)
+              << " rows/s=" << rows / result.seconds / 1e6 << "M"
+              << " GB/s=" << rows * bytes_per_row / result.seconds / 1e9
+              << " conflicts=" << result.conflicts;
+    if (result.verified > 0) {
+        std::cout << " fp32_rechecks=" << result.verified;
+    }
+    std::cout << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const BenchConfig config = load_config();
+    std::cout << "[SCAN] " << config.locks << " locks x " << config.dimension << " dims, "
+              << config.queries << " queries, theta=" << config.theta
+              << " band=" << config.band << ", kernel "
+              << simd_level_name(active_simd_level()) << std::endl;
+
+    std::mt19937 rng(7);
+    TopicSampler sampler(config.dimension, config.topics, rng);
+    CentroidMatrix full;
+    HalfMatrix halves;
+    full.reset(config.dimension);
+    halves.reset(config.dimension);
+    std::vector<float> embedding;
+    for (size_t i = 0; i < config.locks; ++i) {
+        sampler.sample(rng, embedding);
+        full.push_back(embedding.data());
+        halves.push_back(embedding.data());
+    }
+    std::vector<std::vector<float>> queries(config.queries);
+    for (auto& query : queries) {
+        sampler.sample(rng, query);
+    }
+
+    const DotKernel dot = dot_kernel_for_dimension(config.dimension);
+    const size_t dimension = config.dimension;
+    const float theta = config.theta;
+    const float band = config.band;
+
+    const ScanResult fp32 = time_scans(config.repeats, [&](ScanResult& result) {
+        for (const auto& query : queries) {
+            for (size_t row = 0; row < full.size(); ++row) {
+                result.conflicts += dot(query.data(), full.row(row), dimension) >= theta ? 1 : 0;
+            }
+        }
+    });
+    // The same decision path as ActiveLockTable::check_row with
+    // half_precision_centroids on.
+    const ScanResult fp16 = time_scans(config.repeats, [&](ScanResult& result) {
+        for (const auto& query : queries) {
+            for (size_t row = 0; row < halves.size(); ++row) {
+                float similarity = halves.dot(query.data(), row);
+                if (similarity < theta - band) {
+                    continue;
+                }
+                if (similarity < theta + band) {
+                    ++result.verified;
+                    similarity = dot(query.data(), full.row(row), dimension);
+                }
+                result.conflicts += similarity >= theta ? 1 : 0;
+            }
+        }
+    });
+
+    const double rows = static_cast<double>(config.locks) * static_cast<double>(config.queries);
+    print_throughput("fp32", fp32, rows, static_cast<double>(dimension * sizeof(float)));
+    print_throughput("fp16", fp16, rows, static_cast<double>(dimension * sizeof(uint16_t)));
+    std::cout << "[SCAN] fp16 speedup=" << std::setprecision(2)
+              << fp32.seconds / fp16.seconds << "x" << std::endl;
+
+    // How far the fp16 similarities drift, and which decisions they would
+    // flip without the band.
+    double max_drift = 0.0;
+    size_t flipped_raw = 0;
+    size_t flipped_banded = 0;
+    for (const auto& query : queries) {
+        for (size_t row = 0; row < full.size(); ++row) {
+            const float exact = dot(query.data(), full.row(row), dimension);
+            const float rounded = halves.dot(query.data(), row);
+            max_drift = std::max(max_drift, static_cast<double>(std::fabs(exact - rounded)));
+            const bool exact_conflict = exact >= theta;
+            flipped_raw += (rounded >= theta) != exact_conflict ? 1 : 0;
+            const bool in_band = rounded >= theta - band && rounded < theta + band;
+            const float banded = in_band ? exact : rounded;
+            flipped_banded += (banded >= theta) != exact_conflict ? 1 : 0;
+        }
+    }
+    std::cout << "[SCAN] max |fp16 - fp32| similarity=" << std::scientific << std::setprecision(2)
+              << max_drift << " (bound " << HalfMatrix::kUnitRoundingBound << ")" << std::endl;
+    std::cout << "[SCAN] decisions flipped vs fp32: without band=" << flipped_raw
+              << " with band=" << flipped_banded << " of " << static_cast<size_t>(rows)
+              << std::endl;
+    return flipped_banded == 0 || band < HalfMatrix::kUnitRoundingBound ? 0 : 1;
+}
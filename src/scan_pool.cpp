@@ -0,0 +1,104 @@
+// Implements the shared worker pool for parallel conflict scans.
+// Jobs live on their caller's stack; a worker only touches a job between
+// claiming one of its tasks and reporting that task finished, and the caller
+// waits for every task to finish, so a job never outlives its use.
+
+#include "scan_pool.h"
+
+ScanPool::ScanPool(size_t threads) {
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ScanPool::~ScanPool() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ScanPool::run(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    Job job;
+    job.task = &task;
+    job.count = count;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        jobs_.push_back(&job);
+    }
+    work_cv_.notify_all();
+
+    // Work through the batch alongside the workers.
+    for (;;) {
+        size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (job.next == job.count) {
+                break;
+            }
+            index = job.next++;
+        }
+        task(index);
+        finish(job);
+    }
+    {
+        // Fully claimed jobs are normally dropped by claim(); make sure this
+        // one is gone before it leaves scope.
+        std::lock_guard<std::mutex> lock(mu_);
+        for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+            if (*it == &job) {
+                jobs_.erase(it);
+                break;
+            }
+        }
+    }
+    std::unique_lock<std::mutex> done_lock(job.done_mu);
+    job.done_cv.wait(done_lock, [&job]() { return job.finished == job.count; });
+}
+
+bool ScanPool::claim(Job*& job, size_t& index) {
+    while (!jobs_.empty()) {
+        Job* front = jobs_.front();
+        if (front->next == front->count) {
+            jobs_.pop_front();
+            continue;
+        }
+        job = front;
+        index = front->next++;
+        return true;
+    }
+    return false;
+}
+
+void ScanPool::finish(Job& job) {
+    std::lock_guard<std::mutex> done_lock(job.done_mu);
+    if (++job.finished == job.count) {
+        job.done_cv.notify_all();
+    }
+}
+
+void ScanPool::worker_loop() {
+    for (;;) {
+        Job* job = nullptr;
+        size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            work_cv_.wait(lock, [this, &job, &index]() {
+                return stopping_ || claim(job, index);
+            });
+            if (job == nullptr) {
+                return;
+            }
+        }
+        (*job->task)(index);
+        finish(*job);
+    }
+}
@@ -0,0 +1,54 @@
+// Declares the persistent worker pool behind parallel conflict scans.
+// The threads are started once with the lock table; each scan hands them a
+// batch of partitions and the calling thread works through the batch too.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ScanPool {
+public:
+    explicit ScanPool(size_t threads);
+    ~ScanPool();
+
+    ScanPool(const ScanPool&) = delete;
+    ScanPool& operator=(const ScanPool&) = delete;
+
+    size_t thread_count() const { return threads_.size(); }
+
+    // Runs task(0) .. task(count - 1) across the workers and the calling
+    // thread and returns once every call has finished. Concurrent callers
+    // share the workers; since each caller also runs its own tasks, a busy
+    // pool only slows a scan down and never stalls it.
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    struct Job {
+        const std::function<void(size_t)>* task = nullptr;
+        size_t count = 0;
+        // Claimed under mu_; finished under done_mu.
+        size_t next = 0;
+        size_t finished = 0;
+        std::mutex done_mu;
+        std::condition_variable done_cv;
+    };
+
+    // Claims the next task of the oldest job with any left, dropping jobs
+    // that are fully claimed. Returns false once there is nothing to claim.
+    // The caller holds mu_.
+    bool claim(Job*& job, size_t& index);
+    static void finish(Job& job);
+    void worker_loop();
+
+    std::mutex mu_;
+    std::condition_variable work_cv_;
+    std::deque<Job*> jobs_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
@@ -0,0 +1,158 @@
+// Implements SimHash and trained-centroid shard placement and the exact
+// probe-set computation. Random planes are drawn from a fixed seed, so a
+// given dimension always maps the same centroid to the same shard.
+
+#include "simhash_sharder.h"
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace {
+
+// Planes closer than this to the conflict radius are treated as crossable,
+// so float error in the projections can only widen the probe set. Trained
+// cells apply it to q.(c_j - c_i), which is off by no more than the dots.
+constexpr double kRadiusSlack = 1e-4;
+
+double conflict_radius_sine(float threshold) {
+    return threshold <= 0.0f
+        ? 1.0
+        : std::sqrt(std::max(0.0, 1.0 - static_cast<double>(threshold) * threshold));
+}
+
+}  // namespace
+
+SimHashSharder::SimHashSharder(size_t dimension, size_t bits, uint64_t seed)
+    : dimension_(dimension),
+      bits_(dimension == 0 ? 0 : bits),
+      planes_(bits_ * dimension) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (size_t plane = 0; plane < bits_; ++plane) {
+        std::vector<float> normal(dimension_);
+        do {
+            for (float& value : normal) {
+                value = dist(rng);
+            }
+        } while (!normalize_embedding(normal));
+        std::copy(normal.begin(), normal.end(), planes_.begin() + plane * dimension_);
+    }
+}
+
+SimHashSharder::SimHashSharder(size_t dimension, size_t bits, std::vector<float> centroids)
+    : dimension_(dimension),
+      bits_(dimension == 0 ? 0 : bits),
+      centroids_(std::move(centroids)) {
+    const size_t count = dimension_ == 0 || bits_ == 0 ? 0 : centroids_.size() / dimension_;
+    if (count == 0) {
+        bits_ = 0;
+        centroids_.clear();
+        return;
+    }
+    centroids_.resize(count * dimension_);
+    for (size_t c = 0; c < count; ++c) {
+        std::vector<float> row(centroids_.begin() + c * dimension_,
+                               centroids_.begin() + (c + 1) * dimension_);
+        if (normalize_embedding(row)) {
+            std::copy(row.begin(), row.end(), centroids_.begin() + c * dimension_);
+        }
+    }
+    gaps_.resize(count * count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            double squared = 0.0;
+            for (size_t k = 0; k < dimension_; ++k) {
+                const double d = static_cast<double>(centroids_[i * dimension_ + k]) -
+                                 centroids_[j * dimension_ + k];
+                squared += d * d;
+            }
+            gaps_[i * count + j] = static_cast<float>(std::sqrt(squared));
+        }
+    }
+}
+
+size_t SimHashSharder::home_shard(const float* centroid) const {
+    const size_t cells = cell_count();
+    if (cells != 0) {
+        size_t best = 0;
+        float best_similarity = -2.0f;
+        for (size_t c = 0; c < cells; ++c) {
+            const float similarity =
+                dot_product(centroid, centroids_.data() + c * dimension_, dimension_);
+            if (similarity > best_similarity) {
+                best_similarity = similarity;
+                best = c;
+            }
+        }
+        return best % shard_count();
+    }
+    size_t shard = 0;
+    for (size_t plane = 0; plane < bits_; ++plane) {
+        if (project(centroid, plane) >= 0.0f) {
+            shard |= size_t{1} << plane;
+        }
+    }
+    return shard;
+}
+
+void SimHashSharder::probe_shards(const float* query,
+                                  float threshold,
+                                  std::vector<size_t>& out) const {
+    out.clear();
+    // Angular conflict radius is arccos(threshold); a plane is crossable when
+    // the query's distance to it, arcsin(|projection|), is within that radius.
+    const double radius_sine = conflict_radius_sine(threshold);
+    const size_t cells = cell_count();
+    if (cells != 0) {
+        std::vector<float> similarity(cells);
+        for (size_t c = 0; c < cells; ++c) {
+            similarity[c] = dot_product(query, centroids_.data() + c * dimension_, dimension_);
+        }
+        std::vector<bool> probed(shard_count(), false);
+        for (size_t i = 0; i < cells; ++i) {
+            if (probed[i % shard_count()]) {
+                continue;
+            }
+            // The plane between c_i and c_j has unit normal
+            // (c_j - c_i) / |c_j - c_i|; past it, every x is nearer c_j.
+            bool reachable = true;
+            for (size_t j = 0; j < cells && reachable; ++j) {
+                reachable = static_cast<double>(similarity[j]) - similarity[i] <=
+                            radius_sine * gaps_[i * cells + j] + kRadiusSlack;
+            }
+            if (reachable) {
+                probed[i % shard_count()] = true;
+            }
+        }
+        for (size_t shard = 0; shard < probed.size(); ++shard) {
+            if (probed[shard]) {
+                out.push_back(shard);
+            }
+        }
+        return;
+    }
+    size_t fixed = 0;
+    size_t free_mask = 0;
+    for (size_t plane = 0; plane < bits_; ++plane) {
+        const float projection = project(query, plane);
+        if (std::fabs(projection) <= radius_sine + kRadiusSlack) {
+            free_mask |= size_t{1} << plane;
+        } else if (projection > 0.0f) {
+            fixed |= size_t{1} << plane;
+        }
+    }
+    // Enumerate every subset of the free bits.
+    size_t subset = 0;
+    do {
+        out.push_back(fixed | subset);
+        subset = (subset - free_mask) & free_mask;
+    } while (subset != 0);
+    std::sort(out.begin(), out.end());
+}
+
+float SimHashSharder::project(const float* vector, size_t plane) const {
+    return dot_product(vector, planes_.data() + plane * dimension_, dimension_);
+}
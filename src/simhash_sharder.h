@@ -0,0 +1,52 @@
+// Declares the hyperplane placement used by the sharded lock table: random
+// SimHash planes, or the planes between trained centroids. An acquire probes
+// every shard a conflicting centroid could have landed in.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SimHashSharder {
+public:
+    SimHashSharder() = default;
+
+    // `bits` hyperplanes give 2^bits shards; 0 bits means a single shard.
+    SimHashSharder(size_t dimension, size_t bits, uint64_t seed);
+
+    // Trained placement over 2^bits shards: a vector belongs to the cell of
+    // its nearest row of `centroids` (row-major, normalized here, as written
+    // by dscc-ivf-train), and cell c to shard c % 2^bits. Cells are bounded
+    // by the planes halfway between two centroids. Random planes pass within
+    // a few degrees of nearly every high-dimensional embedding, so they
+    // rarely narrow a probe; these planes separate distinct topics.
+    SimHashSharder(size_t dimension, size_t bits, std::vector<float> centroids);
+
+    size_t shard_count() const { return size_t{1} << bits_; }
+
+    // Shard that owns a unit-length centroid.
+    size_t home_shard(const float* centroid) const;
+
+    // Every shard that can hold a unit vector x with dot(query, x) >= threshold,
+    // in ascending order. A hyperplane can only separate the query from such
+    // an x if the query lies within arccos(threshold) of the plane, so only
+    // those bits are left free; the rest must match the query's own bits.
+    // With trained centroids, a cell is skipped when the plane between it and
+    // some other centroid keeps every such x on the other centroid's side.
+    void probe_shards(const float* query, float threshold, std::vector<size_t>& out) const;
+
+    // Number of trained cells; 0 under SimHash placement.
+    size_t cell_count() const { return gaps_.empty() ? 0 : centroids_.size() / dimension_; }
+
+private:
+    float project(const float* vector, size_t plane) const;
+
+    size_t dimension_ = 0;
+    size_t bits_ = 0;
+    // bits_ unit normals, row-major.
+    std::vector<float> planes_;
+    // Trained unit centroids, row-major, and |c_i - c_j| for every pair.
+    std::vector<float> centroids_;
+    std::vector<float> gaps_;
+};
@@ -0,0 +1,917 @@
+// Implements the scalar, AVX2/FMA, and AVX-512 cosine and dot-product kernels,
+// their fixed-dimension specializations, the tiled dot-product matrix used for
+// batched admission, the int8 dot product behind the quantized prefilter, and
+// the fp16 row conversions and dot product behind half-precision centroids.
+// Each SIMD kernel is compiled with a per-function target attribute, so the
+// binary stays portable and only runs the wide paths on CPUs that report them.
+
+#include "similarity_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DSCC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+float finish_cosine(float dot, float norm_a, float norm_b) {
+    if (norm_a <= 0.0f || norm_b <= 0.0f) {
+        return 0.0f;
+    }
+    const float similarity = dot / (std::sqrt(norm_a) * std::sqrt(norm_b));
+    return std::max(-1.0f, std::min(1.0f, similarity));
+}
+
+float cosine_scalar(const float* a, const float* b, size_t size) {
+    float dot[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float norm_a[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float norm_b[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            dot[lane] += a[i + lane] * b[i + lane];
+            norm_a[lane] += a[i + lane] * a[i + lane];
+            norm_b[lane] += b[i + lane] * b[i + lane];
+        }
+    }
+    for (; i < size; ++i) {
+        dot[0] += a[i] * b[i];
+        norm_a[0] += a[i] * a[i];
+        norm_b[0] += b[i] * b[i];
+    }
+    return finish_cosine((dot[0] + dot[1]) + (dot[2] + dot[3]),
+                         (norm_a[0] + norm_a[1]) + (norm_a[2] + norm_a[3]),
+                         (norm_b[0] + norm_b[1]) + (norm_b[2] + norm_b[3]));
+}
+
+float dot_scalar(const float* a, const float* b, size_t size) {
+    float dot[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            dot[lane] += a[i + lane] * b[i + lane];
+        }
+    }
+    for (; i < size; ++i) {
+        dot[0] += a[i] * b[i];
+    }
+    return (dot[0] + dot[1]) + (dot[2] + dot[3]);
+}
+
+// Same four-lane order as dot_scalar with a compile-time trip count, which
+// lets the compiler drop the tail loop. Unlike the SIMD variants the loop is
+// not unrolled completely, only 16 steps (64 floats) at a time.
+template <size_t Dim>
+float dot_fixed_scalar(const float* a, const float* b, size_t /*size*/) {
+    static_assert(Dim % 4 == 0, "fixed scalar kernels need whole 4-float steps");
+    float dot[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+#pragma GCC unroll 16
+    for (size_t i = 0; i < Dim; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            dot[lane] += a[i + lane] * b[i + lane];
+        }
+    }
+    return (dot[0] + dot[1]) + (dot[2] + dot[3]);
+}
+
+int32_t int8_dot_scalar(const int8_t* a, const int8_t* b, size_t size) {
+    int32_t dot = 0;
+    for (size_t i = 0; i < size; ++i) {
+        dot += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return dot;
+}
+
+uint16_t float_to_half_scalar(float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7fffffffu;
+    if (magnitude >= 0x7f800000u) {
+        // Infinity stays infinite; NaN stays a quiet NaN.
+        return sign | (magnitude > 0x7f800000u ? 0x7e00u : 0x7c00u);
+    }
+    if (magnitude >= 0x477ff000u) {
+        // 65520 and up round past the largest half, 65504.
+        return sign | 0x7c00u;
+    }
+    if (magnitude < 0x38800000u) {
+        // Below 2^-14 the result is subnormal, in units of 2^-24; scaling by
+        // a power of two is exact and nearbyint rounds to nearest even.
+        return sign | static_cast<uint16_t>(std::nearbyint(std::fabs(value) * 16777216.0f));
+    }
+    // Rebias the exponent from 127 to 15 and round away the low 13 mantissa
+    // bits to nearest even; a carry correctly bumps the exponent.
+    const uint32_t rounded = magnitude + 0xfffu + ((magnitude >> 13) & 1u);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000u) >> 13);
+}
+
+float half_to_float_scalar(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1fu;
+    const uint32_t mantissa = value & 0x3ffu;
+    if (exponent == 0) {
+        const float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    const uint32_t bits = sign | (exponent == 0x1fu ? 0x7f800000u : (exponent + 112u) << 23) |
+                          (mantissa << 13);
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void convert_to_half_scalar(const float* values, uint16_t* out, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = float_to_half_scalar(values[i]);
+    }
+}
+
+float half_dot_scalar(const float* a, const uint16_t* b, size_t size) {
+    float dot[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            dot[lane] += a[i + lane] * half_to_float_scalar(b[i + lane]);
+        }
+    }
+    for (; i < size; ++i) {
+        dot[0] += a[i] * half_to_float_scalar(b[i]);
+    }
+    return (dot[0] + dot[1]) + (dot[2] + dot[3]);
+}
+
+// Computes a tile_rows x tile_cols block of dot products into `out`, whose
+// rows are out_stride floats apart.
+using DotTileKernel = void (*)(const float* const* a,
+                               const float* const* b,
+                               size_t size,
+                               float* out,
+                               size_t out_stride);
+
+// GEMM-style driver: B is walked in panels small enough to stay in cache
+// while every tile of A streams past it, and each tile reuses its loaded A
+// and B vectors tile_cols and tile_rows times. Edges fall back to `dot`.
+void dot_matrix_tiled(DotTileKernel tile,
+                      size_t tile_rows,
+                      size_t tile_cols,
+                      DotKernel dot,
+                      const float* const* a_rows,
+                      size_t a_count,
+                      const float* const* b_rows,
+                      size_t b_count,
+                      size_t size,
+                      float* out) {
+    constexpr size_t kPanelRows = 64;
+    for (size_t j0 = 0; j0 < b_count; j0 += kPanelRows) {
+        const size_t j1 = std::min(b_count, j0 + kPanelRows);
+        for (size_t i = 0; i < a_count; i += tile_rows) {
+            const size_t rows = std::min(tile_rows, a_count - i);
+            size_t j = j0;
+            if (tile != nullptr && rows == tile_rows) {
+                for (; j + tile_cols <= j1; j += tile_cols) {
+                    tile(a_rows + i, b_rows + j, size, out + i * b_count + j, b_count);
+                }
+            }
+            for (size_t r = i; r < i + rows; ++r) {
+                for (size_t c = j; c < j1; ++c) {
+                    out[r * b_count + c] = dot(a_rows[r], b_rows[c], size);
+                }
+            }
+        }
+    }
+}
+
+void dot_matrix_scalar(const float* const* a_rows,
+                       size_t a_count,
+                       const float* const* b_rows,
+                       size_t b_count,
+                       size_t size,
+                       float* out) {
+    dot_matrix_tiled(nullptr, 1, 1, dot_scalar, a_rows, a_count, b_rows, b_count, size, out);
+}
+
+#ifdef DSCC_X86_KERNELS
+
+__attribute__((target("avx2,fma")))
+float horizontal_sum_avx2(__m256 v) {
+    const __m128 low = _mm256_castps256_ps128(v);
+    const __m128 high = _mm256_extractf128_ps(v, 1);
+    __m128 sum = _mm_add_ps(low, high);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2,fma")))
+float cosine_avx2(const float* a, const float* b, size_t size) {
+    __m256 dot0 = _mm256_setzero_ps();
+    __m256 dot1 = _mm256_setzero_ps();
+    __m256 norm_a0 = _mm256_setzero_ps();
+    __m256 norm_a1 = _mm256_setzero_ps();
+    __m256 norm_b0 = _mm256_setzero_ps();
+    __m256 norm_b1 = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m256 a0 = _mm256_loadu_ps(a + i);
+        const __m256 b0 = _mm256_loadu_ps(b + i);
+        const __m256 a1 = _mm256_loadu_ps(a + i + 8);
+        const __m256 b1 = _mm256_loadu_ps(b + i + 8);
+        dot0 = _mm256_fmadd_ps(a0, b0, dot0);
+        dot1 = _mm256_fmadd_ps(a1, b1, dot1);
+        norm_a0 = _mm256_fmadd_ps(a0, a0, norm_a0);
+        norm_a1 = _mm256_fmadd_ps(a1, a1, norm_a1);
+        norm_b0 = _mm256_fmadd_ps(b0, b0, norm_b0);
+        norm_b1 = _mm256_fmadd_ps(b1, b1, norm_b1);
+    }
+    if (i + 8 <= size) {
+        const __m256 a0 = _mm256_loadu_ps(a + i);
+        const __m256 b0 = _mm256_loadu_ps(b + i);
+        dot0 = _mm256_fmadd_ps(a0, b0, dot0);
+        norm_a0 = _mm256_fmadd_ps(a0, a0, norm_a0);
+        norm_b0 = _mm256_fmadd_ps(b0, b0, norm_b0);
+        i += 8;
+    }
+
+    float dot = horizontal_sum_avx2(_mm256_add_ps(dot0, dot1));
+    float norm_a = horizontal_sum_avx2(_mm256_add_ps(norm_a0, norm_a1));
+    float norm_b = horizontal_sum_avx2(_mm256_add_ps(norm_b0, norm_b1));
+    for (; i < size; ++i) {
+        dot += a[i] * b[i];
+        norm_a += a[i] * a[i];
+        norm_b += b[i] * b[i];
+    }
+    return finish_cosine(dot, norm_a, norm_b);
+}
+
+__attribute__((target("avx2,fma")))
+float dot_avx2(const float* a, const float* b, size_t size) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+
+    float dot = horizontal_sum_avx2(_mm256_add_ps(_mm256_add_ps(acc0, acc1),
+                                                  _mm256_add_ps(acc2, acc3)));
+    for (; i < size; ++i) {
+        dot += a[i] * b[i];
+    }
+    return dot;
+}
+
+// Fixed-dimension variant for the common embedding sizes. Dim is a multiple
+// of 32, so there is no tail and the loop is unrolled completely; the size
+// argument is ignored.
+template <size_t Dim>
+__attribute__((target("avx2,fma")))
+float dot_fixed_avx2(const float* a, const float* b, size_t /*size*/) {
+    static_assert(Dim % 32 == 0, "fixed AVX2 kernels need whole 32-float steps");
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+#pragma GCC unroll 64
+    for (size_t i = 0; i < Dim; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    return horizontal_sum_avx2(_mm256_add_ps(_mm256_add_ps(acc0, acc1),
+                                             _mm256_add_ps(acc2, acc3)));
+}
+
+// 2 x 4 tile: eight accumulators plus six loaded vectors fit the sixteen
+// ymm registers.
+__attribute__((target("avx2,fma")))
+void dot_tile_avx2(const float* const* a,
+                   const float* const* b,
+                   size_t size,
+                   float* out,
+                   size_t out_stride) {
+    __m256 acc[2][4];
+    for (size_t r = 0; r < 2; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            acc[r][c] = _mm256_setzero_ps();
+        }
+    }
+    size_t k = 0;
+    for (; k + 8 <= size; k += 8) {
+        const __m256 a0 = _mm256_loadu_ps(a[0] + k);
+        const __m256 a1 = _mm256_loadu_ps(a[1] + k);
+        for (size_t c = 0; c < 4; ++c) {
+            const __m256 bc = _mm256_loadu_ps(b[c] + k);
+            acc[0][c] = _mm256_fmadd_ps(a0, bc, acc[0][c]);
+            acc[1][c] = _mm256_fmadd_ps(a1, bc, acc[1][c]);
+        }
+    }
+    for (size_t r = 0; r < 2; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            float dot = horizontal_sum_avx2(acc[r][c]);
+            for (size_t tail = k; tail < size; ++tail) {
+                dot += a[r][tail] * b[c][tail];
+            }
+            out[r * out_stride + c] = dot;
+        }
+    }
+}
+
+void dot_matrix_avx2(const float* const* a_rows,
+                     size_t a_count,
+                     const float* const* b_rows,
+                     size_t b_count,
+                     size_t size,
+                     float* out) {
+    dot_matrix_tiled(dot_tile_avx2, 2, 4, dot_avx2, a_rows, a_count, b_rows, b_count, size, out);
+}
+
+// Sign-extends 16 codes to int16 and lets madd form pairwise int32 sums;
+// a pair is at most 2 * 127 * 128, so the int32 lanes cannot overflow.
+__attribute__((target("avx2,fma")))
+int32_t int8_dot_avx2(const int8_t* a, const int8_t* b, size_t size) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i a0 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m256i b0 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const __m256i a1 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)));
+        const __m256i b1 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a0, b0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a1, b1));
+    }
+    if (i + 16 <= size) {
+        const __m256i a0 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m256i b0 = _mm256_cvtepi8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a0, b0));
+        i += 16;
+    }
+
+    const __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    int32_t dot = _mm_cvtsi128_si32(sum);
+    for (; i < size; ++i) {
+        dot += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return dot;
+}
+
+// Widens eight halves at a time with F16C and accumulates in fp32.
+__attribute__((target("avx2,fma,f16c")))
+float half_dot_avx2(const float* a, const uint16_t* b, size_t size) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256 b0 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const __m256 b1 =
+            _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 8)));
+        const __m256 b2 =
+            _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+        const __m256 b3 =
+            _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 24)));
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), b0, acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), b1, acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), b2, acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), b3, acc3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        const __m256 b0 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), b0, acc0);
+    }
+
+    float dot = horizontal_sum_avx2(_mm256_add_ps(_mm256_add_ps(acc0, acc1),
+                                                  _mm256_add_ps(acc2, acc3)));
+    for (; i < size; ++i) {
+        dot += a[i] * half_to_float_scalar(b[i]);
+    }
+    return dot;
+}
+
+__attribute__((target("avx2,f16c")))
+void convert_to_half_f16c(const float* values, uint16_t* out, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+    for (; i < size; ++i) {
+        out[i] = float_to_half_scalar(values[i]);
+    }
+}
+
+__attribute__((target("avx512f")))
+float horizontal_sum_avx512(__m512 v) {
+    // Spilling the lanes avoids the extract/shuffle intrinsics that GCC 12
+    // flags with bogus -Wuninitialized warnings; this runs once per call.
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, v);
+    float sum = 0.0f;
+    for (size_t lane = 0; lane < 8; ++lane) {
+        sum += lanes[lane] + lanes[lane + 8];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+float cosine_avx512(const float* a, const float* b, size_t size) {
+    __m512 dot0 = _mm512_setzero_ps();
+    __m512 dot1 = _mm512_setzero_ps();
+    __m512 norm_a0 = _mm512_setzero_ps();
+    __m512 norm_a1 = _mm512_setzero_ps();
+    __m512 norm_b0 = _mm512_setzero_ps();
+    __m512 norm_b1 = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m512 a0 = _mm512_loadu_ps(a + i);
+        const __m512 b0 = _mm512_loadu_ps(b + i);
+        const __m512 a1 = _mm512_loadu_ps(a + i + 16);
+        const __m512 b1 = _mm512_loadu_ps(b + i + 16);
+        dot0 = _mm512_fmadd_ps(a0, b0, dot0);
+        dot1 = _mm512_fmadd_ps(a1, b1, dot1);
+        norm_a0 = _mm512_fmadd_ps(a0, a0, norm_a0);
+        norm_a1 = _mm512_fmadd_ps(a1, a1, norm_a1);
+        norm_b0 = _mm512_fmadd_ps(b0, b0, norm_b0);
+        norm_b1 = _mm512_fmadd_ps(b1, b1, norm_b1);
+    }
+    for (; i < size; i += 16) {
+        const size_t remaining = std::min<size_t>(16, size - i);
+        const __mmask16 mask = static_cast<__mmask16>((1u << remaining) - 1u);
+        const __m512 a0 = _mm512_maskz_loadu_ps(mask, a + i);
+        const __m512 b0 = _mm512_maskz_loadu_ps(mask, b + i);
+        dot0 = _mm512_fmadd_ps(a0, b0, dot0);
+        norm_a0 = _mm512_fmadd_ps(a0, a0, norm_a0);
+        norm_b0 = _mm512_fmadd_ps(b0, b0, norm_b0);
+    }
+
+    return finish_cosine(horizontal_sum_avx512(_mm512_add_ps(dot0, dot1)),
+                         horizontal_sum_avx512(_mm512_add_ps(norm_a0, norm_a1)),
+                         horizontal_sum_avx512(_mm512_add_ps(norm_b0, norm_b1)));
+}
+
+__attribute__((target("avx512f")))
+float dot_avx512(const float* a, const float* b, size_t size) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+        acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), acc2);
+        acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), acc3);
+    }
+    for (; i < size; i += 16) {
+        const size_t remaining = std::min<size_t>(16, size - i);
+        const __mmask16 mask = static_cast<__mmask16>((1u << remaining) - 1u);
+        acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                               _mm512_maskz_loadu_ps(mask, b + i),
+                               acc0);
+    }
+    return horizontal_sum_avx512(_mm512_add_ps(_mm512_add_ps(acc0, acc1),
+                                               _mm512_add_ps(acc2, acc3)));
+}
+
+// Fixed-dimension variant; Dim is a multiple of 64, so no masked tail.
+template <size_t Dim>
+__attribute__((target("avx512f")))
+float dot_fixed_avx512(const float* a, const float* b, size_t /*size*/) {
+    static_assert(Dim % 64 == 0, "fixed AVX-512 kernels need whole 64-float steps");
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+#pragma GCC unroll 32
+    for (size_t i = 0; i < Dim; i += 64) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+        acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), acc2);
+        acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), acc3);
+    }
+    return horizontal_sum_avx512(_mm512_add_ps(_mm512_add_ps(acc0, acc1),
+                                               _mm512_add_ps(acc2, acc3)));
+}
+
+// 4 x 4 tile: sixteen accumulators plus eight loaded vectors fit the
+// thirty-two zmm registers.
+__attribute__((target("avx512f")))
+void dot_tile_avx512(const float* const* a,
+                     const float* const* b,
+                     size_t size,
+                     float* out,
+                     size_t out_stride) {
+    __m512 acc[4][4];
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            acc[r][c] = _mm512_setzero_ps();
+        }
+    }
+    for (size_t k = 0; k < size; k += 16) {
+        const size_t remaining = std::min<size_t>(16, size - k);
+        const __mmask16 mask = static_cast<__mmask16>((1u << remaining) - 1u);
+        __m512 av[4];
+        __m512 bv[4];
+        for (size_t i = 0; i < 4; ++i) {
+            av[i] = _mm512_maskz_loadu_ps(mask, a[i] + k);
+            bv[i] = _mm512_maskz_loadu_ps(mask, b[i] + k);
+        }
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t c = 0; c < 4; ++c) {
+                acc[r][c] = _mm512_fmadd_ps(av[r], bv[c], acc[r][c]);
+            }
+        }
+    }
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            out[r * out_stride + c] = horizontal_sum_avx512(acc[r][c]);
+        }
+    }
+}
+
+void dot_matrix_avx512(const float* const* a_rows,
+                       size_t a_count,
+                       const float* const* b_rows,
+                       size_t b_count,
+                       size_t size,
+                       float* out) {
+    dot_matrix_tiled(dot_tile_avx512, 4, 4, dot_avx512, a_rows, a_count, b_rows, b_count, size, out);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+int32_t int8_dot_avx512(const int8_t* a, const int8_t* b, size_t size) {
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m512i a0 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        const __m512i b0 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const __m512i a1 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32)));
+        const __m512i b1 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)));
+        acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(a0, b0));
+        acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(a1, b1));
+    }
+    if (i + 32 <= size) {
+        const __m512i a0 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        const __m512i b0 = _mm512_cvtepi8_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(a0, b0));
+        i += 32;
+    }
+
+    // Same spill-and-sum as horizontal_sum_avx512, for the same GCC reason.
+    alignas(64) int32_t lanes[16];
+    _mm512_store_si512(lanes, _mm512_add_epi32(acc0, acc1));
+    int32_t dot = 0;
+    for (const int32_t lane : lanes) {
+        dot += lane;
+    }
+    for (; i < size; ++i) {
+        dot += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return dot;
+}
+
+// maskz_cvtph_ps rather than cvtph_ps: GCC 12 flags the unmasked form with a
+// bogus -Wuninitialized warning.
+__attribute__((target("avx512f")))
+float half_dot_avx512(const float* a, const uint16_t* b, size_t size) {
+    constexpr __mmask16 kAll = 0xffff;
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m512 b0 = _mm512_maskz_cvtph_ps(
+            kAll, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const __m512 b1 = _mm512_maskz_cvtph_ps(
+            kAll, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 16)));
+        const __m512 b2 = _mm512_maskz_cvtph_ps(
+            kAll, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)));
+        const __m512 b3 = _mm512_maskz_cvtph_ps(
+            kAll, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 48)));
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), b0, acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), b1, acc1);
+        acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), b2, acc2);
+        acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), b3, acc3);
+    }
+    for (; i + 16 <= size; i += 16) {
+        const __m512 b0 = _mm512_maskz_cvtph_ps(
+            kAll, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), b0, acc0);
+    }
+
+    float dot = horizontal_sum_avx512(_mm512_add_ps(_mm512_add_ps(acc0, acc1),
+                                                    _mm512_add_ps(acc2, acc3)));
+    for (; i < size; ++i) {
+        dot += a[i] * half_to_float_scalar(b[i]);
+    }
+    return dot;
+}
+
+#endif  // DSCC_X86_KERNELS
+
+// The fixed-dimension kernel for `level`; the caller has already checked
+// that the CPU supports it.
+template <size_t Dim>
+DotKernel fixed_dot_kernel_for(SimdLevel level) {
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return dot_fixed_avx512<Dim>;
+        case SimdLevel::kAvx2:
+            return dot_fixed_avx2<Dim>;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return dot_fixed_scalar<Dim>;
+}
+
+}  // namespace
+
+SimdLevel detect_simd_level() {
+#ifdef DSCC_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::kAvx2;
+    }
+#endif
+    return SimdLevel::kScalar;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::kAvx512:
+            return "avx512";
+        case SimdLevel::kAvx2:
+            return "avx2+fma";
+        case SimdLevel::kScalar:
+            break;
+    }
+    return "scalar";
+}
+
+CosineKernel cosine_kernel_for(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return cosine_avx512;
+        case SimdLevel::kAvx2:
+            return cosine_avx2;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return cosine_scalar;
+}
+
+DotKernel dot_kernel_for(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return dot_avx512;
+        case SimdLevel::kAvx2:
+            return dot_avx2;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return dot_scalar;
+}
+
+DotKernel dot_kernel_for(SimdLevel level, size_t dimension) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (dimension) {
+        case 384:
+            return fixed_dot_kernel_for<384>(level);
+        case 768:
+            return fixed_dot_kernel_for<768>(level);
+        case 1024:
+            return fixed_dot_kernel_for<1024>(level);
+        case 1536:
+            return fixed_dot_kernel_for<1536>(level);
+        default:
+            return dot_kernel_for(level);
+    }
+}
+
+DotMatrixKernel dot_matrix_kernel_for(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return dot_matrix_avx512;
+        case SimdLevel::kAvx2:
+            return dot_matrix_avx2;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return dot_matrix_scalar;
+}
+
+Int8DotKernel int8_dot_kernel_for(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            // The byte-width instructions need AVX-512BW on top of AVX-512F.
+            return __builtin_cpu_supports("avx512bw") ? int8_dot_avx512 : int8_dot_avx2;
+        case SimdLevel::kAvx2:
+            return int8_dot_avx2;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return int8_dot_scalar;
+}
+
+HalfDotKernel half_dot_kernel_for(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        return nullptr;
+    }
+    switch (level) {
+#ifdef DSCC_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return half_dot_avx512;
+        case SimdLevel::kAvx2:
+            // F16C came in before AVX2, but check rather than assume.
+            return __builtin_cpu_supports("f16c") ? half_dot_avx2 : half_dot_scalar;
+#else
+        case SimdLevel::kAvx512:
+        case SimdLevel::kAvx2:
+            return nullptr;
+#endif
+        case SimdLevel::kScalar:
+            break;
+    }
+    return half_dot_scalar;
+}
+
+SimdLevel active_simd_level() {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+float cosine_similarity(const float* a, const float* b, size_t size) {
+    static const CosineKernel kernel = cosine_kernel_for(active_simd_level());
+    return kernel(a, b, size);
+}
+
+float dot_product(const float* a, const float* b, size_t size) {
+    static const DotKernel kernel = dot_kernel_for(active_simd_level());
+    return kernel(a, b, size);
+}
+
+DotKernel dot_kernel_for_dimension(size_t dimension) {
+    return dot_kernel_for(active_simd_level(), dimension);
+}
+
+void dot_product_matrix(const float* const* a_rows,
+                        size_t a_count,
+                        const float* const* b_rows,
+                        size_t b_count,
+                        size_t size,
+                        float* out) {
+    static const DotMatrixKernel kernel = dot_matrix_kernel_for(active_simd_level());
+    kernel(a_rows, a_count, b_rows, b_count, size, out);
+}
+
+int32_t dot_product_int8(const int8_t* a, const int8_t* b, size_t size) {
+    static const Int8DotKernel kernel = int8_dot_kernel_for(active_simd_level());
+    return kernel(a, b, size);
+}
+
+float dot_product_half(const float* a, const uint16_t* b, size_t size) {
+    static const HalfDotKernel kernel = half_dot_kernel_for(active_simd_level());
+    return kernel(a, b, size);
+}
+
+void convert_to_half(const float* values, uint16_t* out, size_t size) {
+#ifdef DSCC_X86_KERNELS
+    static const bool use_f16c =
+        active_simd_level() != SimdLevel::kScalar && __builtin_cpu_supports("f16c");
+    if (use_f16c) {
+        convert_to_half_f16c(values, out, size);
+        return;
+    }
+#endif
+    convert_to_half_scalar(values, out, size);
+}
+
+float half_to_float(uint16_t value) {
+    return half_to_float_scalar(value);
+}
+
+bool normalize_embedding(std::vector<float>& embedding) {
+    if (embedding.empty()) {
+        return false;
+    }
+
+    double norm = 0.0;
+    for (const float value : embedding) {
+        if (!std::isfinite(value)) {
+            return false;
+        }
+        norm += static_cast<double>(value) * static_cast<double>(value);
+    }
+    if (!(norm > 0.0) || !std::isfinite(norm)) {
+        return false;
+    }
+
+    const double scale = 1.0 / std::sqrt(norm);
+    for (float& value : embedding) {
+        value = static_cast<float>(static_cast<double>(value) * scale);
+    }
+    return true;
+}
+
+double cosine_similarity_reference(const float* a, const float* b, size_t size) {
+    double dot = 0.0;
+    double norm_a = 0.0;
+    double norm_b = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+        dot += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+        norm_a += static_cast<double>(a[i]) * static_cast<double>(a[i]);
+        norm_b += static_cast<double>(b[i]) * static_cast<double>(b[i]);
+    }
+    if (norm_a <= 0.0 || norm_b <= 0.0) {
+        return 0.0;
+    }
+    const double similarity = dot / (std::sqrt(norm_a) * std::sqrt(norm_b));
+    return std::max(-1.0, std::min(1.0, similarity));
+}
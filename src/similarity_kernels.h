@@ -0,0 +1,93 @@
+// Declares the vectorized similarity kernels used by the semantic lock table.
+// The widest instruction set the CPU supports is picked once at startup.
+// active_lock_table.cpp calls into these instead of looping over vectors itself.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class SimdLevel {
+    kScalar,
+    kAvx2,
+    kAvx512,
+};
+
+using CosineKernel = float (*)(const float* a, const float* b, size_t size);
+using DotKernel = float (*)(const float* a, const float* b, size_t size);
+using DotMatrixKernel = void (*)(const float* const* a_rows,
+                                 size_t a_count,
+                                 const float* const* b_rows,
+                                 size_t b_count,
+                                 size_t size,
+                                 float* out);
+using Int8DotKernel = int32_t (*)(const int8_t* a, const int8_t* b, size_t size);
+// `b` holds IEEE binary16 values.
+using HalfDotKernel = float (*)(const float* a, const uint16_t* b, size_t size);
+
+SimdLevel detect_simd_level();
+
+const char* simd_level_name(SimdLevel level);
+
+// Returns the kernel for the requested level, or nullptr when this build or
+// CPU cannot run it. The scalar kernel is always available.
+CosineKernel cosine_kernel_for(SimdLevel level);
+DotKernel dot_kernel_for(SimdLevel level);
+DotMatrixKernel dot_matrix_kernel_for(SimdLevel level);
+Int8DotKernel int8_dot_kernel_for(SimdLevel level);
+HalfDotKernel half_dot_kernel_for(SimdLevel level);
+
+// Dot kernel for vectors of exactly `dimension` floats. The common embedding
+// sizes (384, 768, 1024, 1536) get a specialization with no tail handling,
+// unrolled completely at the SIMD levels and 16 steps at a time in scalar
+// code; any other size gets dot_kernel_for(level). The size argument of a
+// specialized kernel is ignored.
+DotKernel dot_kernel_for(SimdLevel level, size_t dimension);
+
+// Level chosen by detect_simd_level() on first use.
+SimdLevel active_simd_level();
+
+// Clamped cosine similarity in float precision through the active kernel.
+float cosine_similarity(const float* a, const float* b, size_t size);
+
+// Plain dot product through the active kernel. For unit-length inputs this is
+// the cosine similarity, which is how the lock table compares embeddings.
+float dot_product(const float* a, const float* b, size_t size);
+
+// dot_kernel_for(active_simd_level(), dimension), for callers that compare
+// many vectors of one fixed dimension and resolve the kernel once.
+DotKernel dot_kernel_for_dimension(size_t dimension);
+
+// All pairwise dot products between two sets of rows, through the active
+// kernel: out[i * b_count + j] = dot(a_rows[i], b_rows[j]). Cache-tiled, so
+// evaluating many queries against the same rows costs far less than calling
+// dot_product for each pair.
+void dot_product_matrix(const float* const* a_rows,
+                        size_t a_count,
+                        const float* const* b_rows,
+                        size_t b_count,
+                        size_t size,
+                        float* out);
+
+// Exact integer dot product of two int8 code rows through the active kernel.
+// Used by the quantized prefilter; it reads a quarter of the bytes of the
+// float kernels.
+int32_t dot_product_int8(const int8_t* a, const int8_t* b, size_t size);
+
+// Dot product of an fp32 vector with an fp16 row through the active kernel.
+// The halves are widened to fp32 before multiplying and the sum is kept in
+// fp32, so the only error beyond dot_product is the rounding of the row.
+float dot_product_half(const float* a, const uint16_t* b, size_t size);
+
+// IEEE binary16 conversion, rounding to nearest even. Uses F16C when the CPU
+// has it; the scalar fallback gives bit-identical results.
+void convert_to_half(const float* values, uint16_t* out, size_t size);
+float half_to_float(uint16_t value);
+
+// Scales the embedding to unit length in place. Returns false, leaving the
+// values unspecified, for empty, zero, or non-finite vectors.
+bool normalize_embedding(std::vector<float>& embedding);
+
+// Double-precision reference used to check kernel accuracy.
+double cosine_similarity_reference(const float* a, const float* b, size_t size);
@@ -3,15 +3,26 @@
 // Use e2e_bench.cpp when you want Docker, embeddings, gRPC, and Qdrant involved.
 
 #include "active_lock_table.h"
+#include "half_matrix.h"
+#include "hnsw_index.h"
+#include "ivf_index.h"
+#include "quantized_matrix.h"
+#include "similarity_kernels.h"
+#include "simhash_sharder.h"
 #include "threadsafe_log.h"
+#include "timer_wheel.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <random>
+#include <unordered_set>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -121,8 +132,9 @@ TestOutcome run_case(const std::string& case_name,
                      float threshold,
                      bool expect_serialized,
                      const std::string& case_title,
-                     const std::string& expectation_text) {
-    ActiveLockTable table;
+                     const std::string& expectation_text,
+                     const ActiveLockTableOptions& options = ActiveLockTableOptions()) {
+    ActiveLockTable table(options);
     const size_t thread_count = embeddings.size();
     std::vector<AgentInterval> intervals(thread_count);
     std::vector<std::thread> threads;
@@ -239,8 +251,1471 @@ TestOutcome run_case(const std::string& case_name,
     return outcome;
 }
 
+bool run_kernel_accuracy_check() {
+    constexpr double kTolerance = 2e-5;
+    constexpr size_t kPairs = 200;
+    const std::vector<size_t> dims = {7, 384, 768, 1024, 1536};
+    const std::vector<SimdLevel> levels = {
+        SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512};
+
+    log_line("------------------------------------------------------------");
+    log_line("Kernel-Check - SIMD cosine, unit-vector dot, dot matrix, and int8 kernels against reference paths");
+    log_line(std::string("Active kernel: ") + simd_level_name(active_simd_level()));
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    bool pass = true;
+    for (const SimdLevel level : levels) {
+        const CosineKernel kernel = cosine_kernel_for(level);
+        const DotKernel dot_kernel = dot_kernel_for(level);
+        const DotMatrixKernel matrix_kernel = dot_matrix_kernel_for(level);
+        const Int8DotKernel int8_kernel = int8_dot_kernel_for(level);
+        if (kernel == nullptr || dot_kernel == nullptr || matrix_kernel == nullptr ||
+            int8_kernel == nullptr) {
+            log_line(std::string("  ") + simd_level_name(level) + " -> unsupported on this CPU, skipped");
+            continue;
+        }
+        for (const size_t dim : dims) {
+            // The unrolled specialization for this dimension, if it has one.
+            const DotKernel fixed_kernel = dot_kernel_for(level, dim);
+            double max_error = 0.0;
+            bool int8_exact = true;
+            std::vector<float> a(dim);
+            std::vector<float> b(dim);
+            std::vector<int8_t> codes_a(dim);
+            std::vector<int8_t> codes_b(dim);
+            for (size_t pair = 0; pair < kPairs; ++pair) {
+                for (size_t i = 0; i < dim; ++i) {
+                    a[i] = dist(rng);
+                    b[i] = 0.7f * a[i] + 0.3f * dist(rng);
+                }
+                const double expected = cosine_similarity_reference(a.data(), b.data(), dim);
+                const double actual = kernel(a.data(), b.data(), dim);
+                max_error = std::max(max_error, std::fabs(expected - actual));
+
+                normalize_embedding(a);
+                normalize_embedding(b);
+                const double actual_dot = dot_kernel(a.data(), b.data(), dim);
+                max_error = std::max(max_error, std::fabs(expected - actual_dot));
+                const double fixed_dot = fixed_kernel(a.data(), b.data(), dim);
+                max_error = std::max(max_error, std::fabs(expected - fixed_dot));
+
+                int32_t expected_int8 = 0;
+                for (size_t i = 0; i < dim; ++i) {
+                    codes_a[i] = static_cast<int8_t>(static_cast<int>(rng() % 255) - 127);
+                    codes_b[i] = static_cast<int8_t>(static_cast<int>(rng() % 255) - 127);
+                    expected_int8 += static_cast<int32_t>(codes_a[i]) * codes_b[i];
+                }
+                int8_exact = int8_exact &&
+                             int8_kernel(codes_a.data(), codes_b.data(), dim) == expected_int8;
+            }
+
+            // Odd row counts exercise the tile edges as well as full tiles.
+            constexpr size_t kMatrixA = 7;
+            constexpr size_t kMatrixB = 70;
+            std::vector<std::vector<float>> matrix_rows(kMatrixA + kMatrixB, std::vector<float>(dim));
+            std::vector<const float*> row_ptrs;
+            for (auto& row : matrix_rows) {
+                for (float& value : row) {
+                    value = dist(rng);
+                }
+                normalize_embedding(row);
+                row_ptrs.push_back(row.data());
+            }
+            std::vector<float> products(kMatrixA * kMatrixB);
+            matrix_kernel(row_ptrs.data(), kMatrixA, row_ptrs.data() + kMatrixA, kMatrixB, dim,
+                          products.data());
+            for (size_t i = 0; i < kMatrixA; ++i) {
+                for (size_t j = 0; j < kMatrixB; ++j) {
+                    const double expected = cosine_similarity_reference(
+                        row_ptrs[i], row_ptrs[kMatrixA + j], dim);
+                    max_error = std::max(max_error, std::fabs(expected - products[i * kMatrixB + j]));
+                }
+            }
+            const bool ok = max_error <= kTolerance && int8_exact;
+            pass = pass && ok;
+            std::ostringstream oss;
+            oss << "  " << simd_level_name(level) << " dim=" << dim
+                << (fixed_kernel != dot_kernel ? " fixed" : "") << " max_abs_error=" << std::scientific << std::setprecision(2) << max_error
+                << (int8_exact ? " int8=exact" : " int8=MISMATCH")
+                << (ok ? " ok" : " TOO LARGE");
+            log_line(oss.str());
+        }
+    }
+    log_line(std::string("Kernel-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Unit embeddings scattered around random topic directions, with a per-topic
+// spread, so tight and loose clusters both show up above theta.
+class TopicSampler {
+public:
+    TopicSampler(size_t dim, size_t topics, std::mt19937& rng)
+        : topics_(topics, std::vector<float>(dim)),
+          noise_(topics) {
+        std::uniform_real_distribution<float> spread(0.3f, 0.9f);
+        for (size_t t = 0; t < topics; ++t) {
+            for (float& value : topics_[t]) {
+                value = dist_(rng);
+            }
+            normalize_embedding(topics_[t]);
+            noise_[t] = spread(rng) / std::sqrt(static_cast<float>(dim));
+        }
+    }
+
+    std::vector<float> operator()(std::mt19937& rng) {
+        const size_t t = rng() % topics_.size();
+        std::vector<float> v = topics_[t];
+        for (float& value : v) {
+            value += noise_[t] * dist_(rng);
+        }
+        normalize_embedding(v);
+        return v;
+    }
+
+private:
+    std::vector<std::vector<float>> topics_;
+    std::vector<float> noise_;
+    std::normal_distribution<float> dist_{0.0f, 1.0f};
+};
+
+struct RecallStats {
+    size_t candidates = 0;
+    size_t true_hits = 0;
+    size_t found_hits = 0;
+    size_t conflicting_queries = 0;
+    size_t detected_queries = 0;
+};
+
+RecallStats measure_index_recall(ConflictIndex& index,
+                                 const std::vector<std::vector<float>>& locks,
+                                 const std::vector<bool>& live,
+                                 const std::vector<std::vector<float>>& queries,
+                                 float threshold) {
+    RecallStats stats;
+    std::vector<uint64_t> candidates;
+    for (const auto& query : queries) {
+        std::unordered_set<uint64_t> expected;
+        for (size_t i = 0; i < locks.size(); ++i) {
+            if (live[i] &&
+                dot_product(query.data(), locks[i].data(), query.size()) >= threshold) {
+                expected.insert(i);
+            }
+        }
+        candidates.clear();
+        index.candidates(query.data(), threshold, candidates);
+        stats.candidates += candidates.size();
+        size_t found = 0;
+        for (const uint64_t id : candidates) {
+            found += expected.count(id);
+        }
+        stats.true_hits += expected.size();
+        stats.found_hits += found;
+        if (!expected.empty()) {
+            ++stats.conflicting_queries;
+            stats.detected_queries += found > 0 ? 1 : 0;
+        }
+    }
+    return stats;
+}
+
+// The first acquire fixes the table's dimension: once it is released and the
+// table is empty again, a different dimension is still turned away.
+bool run_dimension_lock_check() {
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Dimension-Check - the first acquire fixes the table dimension");
+
+    std::vector<float> first(384, 1.0f);
+    std::vector<float> other(768, 1.0f);
+    normalize_embedding(first);
+    normalize_embedding(other);
+    ActiveLockTable table;
+    const AcquireTrace granted = table.acquire("first", first, kTheta);
+    table.release("first");
+    const AcquireTrace rejected = table.acquire("other", other, kTheta);
+
+    const bool pass = granted.status == AcquireStatus::kGranted &&
+                      rejected.status == AcquireStatus::kDimensionMismatch &&
+                      rejected.table_dimension == first.size() && table.size() == 0;
+    std::ostringstream oss;
+    oss << "  dim=" << other.size() << " after dim=" << first.size() << " -> "
+        << (rejected.status == AcquireStatus::kDimensionMismatch ? "rejected" : "accepted")
+        << " table_dimension=" << rejected.table_dimension;
+    log_line(oss.str());
+    log_line(std::string("Dimension-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+bool run_hnsw_recall_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 60;
+    constexpr size_t kLocks = 6000;
+    constexpr size_t kQueries = 600;
+    constexpr double kMinDecisionRecall = 0.99;
+    constexpr double kMinHitRecall = 0.95;
+
+    log_line("------------------------------------------------------------");
+    log_line("HNSW-Check - HNSW conflict candidates against the exact linear scan");
+
+    std::mt19937 rng(7);
+    TopicSampler sample(kDim, kTopics, rng);
+
+    std::vector<std::vector<float>> locks(kLocks);
+    std::vector<bool> live(kLocks, true);
+    HnswIndex index(kDim, HnswParams{});
+    for (size_t i = 0; i < kLocks; ++i) {
+        locks[i] = sample(rng);
+        index.insert(i, locks[i].data());
+    }
+    std::vector<std::vector<float>> queries(kQueries);
+    for (auto& query : queries) {
+        query = sample(rng);
+    }
+
+    bool pass = true;
+    const auto report = [&](const std::string& phase, float threshold) {
+        const RecallStats stats = measure_index_recall(index, locks, live, queries, threshold);
+        const double hit_recall = stats.true_hits == 0
+            ? 1.0 : static_cast<double>(stats.found_hits) / static_cast<double>(stats.true_hits);
+        const double decision_recall = stats.conflicting_queries == 0
+            ? 1.0 : static_cast<double>(stats.detected_queries) /
+                    static_cast<double>(stats.conflicting_queries);
+        const bool ok = hit_recall >= kMinHitRecall && decision_recall >= kMinDecisionRecall;
+        pass = pass && ok;
+        std::ostringstream oss;
+        oss << "  " << phase << " theta=" << std::fixed << std::setprecision(2) << threshold
+            << " locks=" << index.size()
+            << " conflicting_queries=" << stats.conflicting_queries
+            << " decision_recall=" << std::setprecision(4) << decision_recall
+            << " hit_recall=" << hit_recall << (ok ? " ok" : " TOO LOW");
+        log_line(oss.str());
+    };
+
+    report("after-insert", 0.78f);
+    report("after-insert", 0.85f);
+    for (size_t i = 0; i < kLocks; ++i) {
+        if (rng() % 5 < 2) {
+            live[i] = false;
+            index.remove(i);
+        }
+    }
+    report("after-churn", 0.78f);
+    report("after-churn", 0.85f);
+
+    log_line(std::string("HNSW-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+bool run_quantized_prefilter_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 60;
+    constexpr size_t kLocks = 4000;
+    constexpr size_t kQueries = 300;
+
+    log_line("------------------------------------------------------------");
+    log_line("Quantized-Check - int8 similarity bound must never reject a real conflict");
+
+    std::mt19937 rng(13);
+    TopicSampler sample(kDim, kTopics, rng);
+    std::vector<std::vector<float>> locks(kLocks);
+    QuantizedMatrix quantized;
+    quantized.reset(kDim);
+    for (auto& lock : locks) {
+        lock = sample(rng);
+        quantized.push_back(lock.data());
+    }
+
+    bool pass = true;
+    QuantizedRow query_codes;
+    for (const float threshold : {0.78f, 0.85f}) {
+        size_t conflicts = 0;
+        size_t exact_checks = 0;
+        size_t missed = 0;
+        double max_gap = 0.0;
+        for (size_t q = 0; q < kQueries; ++q) {
+            const std::vector<float> query = sample(rng);
+            quantize_row(query.data(), kDim, query_codes);
+            for (size_t i = 0; i < kLocks; ++i) {
+                const float exact = dot_product(query.data(), locks[i].data(), kDim);
+                const float bound = quantized.similarity_upper_bound(query_codes, i);
+                max_gap = std::max(max_gap, static_cast<double>(bound - exact));
+                const bool conflict = exact >= threshold;
+                const bool kept = bound >= threshold - ActiveLockTableOptions().quantized_band;
+                conflicts += conflict ? 1 : 0;
+                exact_checks += kept ? 1 : 0;
+                missed += (conflict && !kept) ? 1 : 0;
+            }
+        }
+        const bool ok = missed == 0;
+        pass = pass && ok;
+        std::ostringstream oss;
+        oss << "  theta=" << std::fixed << std::setprecision(2) << threshold
+            << " conflicts=" << conflicts
+            << " exact_checks=" << exact_checks << "/" << kLocks * kQueries
+            << " max_bound_gap=" << std::setprecision(4) << max_gap
+            << " missed=" << missed << (ok ? " ok" : " UNSOUND");
+        log_line(oss.str());
+    }
+
+    log_line(std::string("Quantized-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// fp16 rows may drift from fp32 by at most HalfMatrix::kUnitRoundingBound, on
+// every half kernel, so the default band never lets a decision change.
+bool run_half_precision_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 60;
+    constexpr size_t kLocks = 2000;
+    constexpr size_t kQueries = 100;
+    constexpr float kTheta = 0.85f;
+    const float band = ActiveLockTableOptions().half_precision_band;
+
+    log_line("------------------------------------------------------------");
+    log_line("Half-Check - fp16 centroids stay within the rounding bound of fp32");
+
+    std::mt19937 rng(17);
+    TopicSampler sample(kDim, kTopics, rng);
+    std::vector<std::vector<float>> locks(kLocks);
+    HalfMatrix halves;
+    halves.reset(kDim);
+    for (auto& lock : locks) {
+        lock = sample(rng);
+        halves.push_back(lock.data());
+    }
+    std::vector<std::vector<float>> queries(kQueries);
+    for (auto& query : queries) {
+        query = sample(rng);
+    }
+
+    bool pass = true;
+    for (const SimdLevel level : {SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+        const HalfDotKernel kernel = half_dot_kernel_for(level);
+        if (kernel == nullptr) {
+            continue;
+        }
+        double max_drift = 0.0;
+        size_t rechecks = 0;
+        size_t flipped = 0;
+        for (const auto& query : queries) {
+            for (size_t i = 0; i < kLocks; ++i) {
+                const float exact = dot_product(query.data(), locks[i].data(), kDim);
+                const float rounded = kernel(query.data(), halves.row(i), kDim);
+                max_drift = std::max(max_drift, static_cast<double>(std::fabs(exact - rounded)));
+                const bool in_band = rounded >= kTheta - band && rounded < kTheta + band;
+                rechecks += in_band ? 1 : 0;
+                flipped += ((in_band ? exact : rounded) >= kTheta) != (exact >= kTheta) ? 1 : 0;
+            }
+        }
+        const bool ok = max_drift <= HalfMatrix::kUnitRoundingBound && flipped == 0;
+        pass = pass && ok;
+        std::ostringstream oss;
+        oss << "  " << simd_level_name(level) << " max_drift=" << std::scientific
+            << std::setprecision(2) << max_drift << " fp32_rechecks=" << rechecks << "/"
+            << kLocks * kQueries << " flipped=" << flipped << (ok ? " ok" : " UNSOUND");
+        log_line(oss.str());
+    }
+
+    log_line(std::string("Half-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Random SimHash planes pass within a few degrees of nearly every
+// 384-dimensional embedding, so there every probe takes every shard; the
+// planes between centroids trained on the workload must narrow it.
+bool run_shard_probe_check() {
+    constexpr size_t kBits = 4;
+    constexpr size_t kTopics = 12;
+    constexpr size_t kLocks = 3000;
+    constexpr size_t kQueries = 300;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Shard-Check - probe sets must cover every conflicting lock's shard");
+
+    bool pass = true;
+    for (const size_t dim : {8, 384}) {
+        std::mt19937 rng(17);
+        TopicSampler sample(dim, kTopics, rng);
+        std::vector<std::vector<float>> locks(kLocks);
+        std::vector<float> samples;
+        for (size_t i = 0; i < kLocks; ++i) {
+            locks[i] = sample(rng);
+            samples.insert(samples.end(), locks[i].begin(), locks[i].end());
+        }
+        std::vector<std::vector<float>> queries(kQueries);
+        for (auto& query : queries) {
+            query = sample(rng);
+        }
+
+        for (const bool trained : {false, true}) {
+            const SimHashSharder sharder =
+                trained ? SimHashSharder(dim, kBits,
+                                         train_ivf_centroids(samples, dim, size_t{1} << kBits, 10, 5))
+                        : SimHashSharder(dim, kBits, 99);
+            std::vector<size_t> homes(kLocks);
+            for (size_t i = 0; i < kLocks; ++i) {
+                homes[i] = sharder.home_shard(locks[i].data());
+            }
+
+            size_t conflicts = 0;
+            size_t missed = 0;
+            size_t probed = 0;
+            std::vector<size_t> probe;
+            for (const auto& query : queries) {
+                sharder.probe_shards(query.data(), kTheta, probe);
+                probed += probe.size();
+                for (size_t i = 0; i < kLocks; ++i) {
+                    if (dot_product(query.data(), locks[i].data(), dim) < kTheta) {
+                        continue;
+                    }
+                    ++conflicts;
+                    if (!std::binary_search(probe.begin(), probe.end(), homes[i])) {
+                        ++missed;
+                    }
+                }
+            }
+            const double mean_probed = static_cast<double>(probed) / kQueries;
+            const bool narrowed = !trained || dim < 384 ||
+                                  mean_probed < static_cast<double>(sharder.shard_count());
+            const bool ok = missed == 0 && narrowed;
+            pass = pass && ok;
+            std::ostringstream oss;
+            oss << "  dim=" << dim << " placement=" << (trained ? "trained" : "simhash")
+                << " shards=" << sharder.shard_count() << " conflicts=" << conflicts
+                << " missed=" << missed << " mean_probed_shards=" << std::fixed
+                << std::setprecision(2) << mean_probed
+                << (missed != 0 ? " UNSOUND" : !narrowed ? " NOT NARROWED" : " ok");
+            log_line(oss.str());
+        }
+    }
+
+    log_line(std::string("Shard-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+bool run_ivf_exactness_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 60;
+    constexpr size_t kBuckets = 64;
+    constexpr size_t kLocks = 6000;
+    constexpr size_t kQueries = 600;
+
+    log_line("------------------------------------------------------------");
+    log_line("IVF-Check - IVF bucket pruning must match the exact linear scan");
+
+    std::mt19937 rng(11);
+    TopicSampler sample(kDim, kTopics, rng);
+
+    std::vector<float> training;
+    for (size_t i = 0; i < 4000; ++i) {
+        const std::vector<float> v = sample(rng);
+        training.insert(training.end(), v.begin(), v.end());
+    }
+    IvfIndex index(kDim, train_ivf_centroids(training, kDim, kBuckets, 20, 3));
+
+    std::vector<std::vector<float>> locks(kLocks);
+    std::vector<bool> live(kLocks, true);
+    for (size_t i = 0; i < kLocks; ++i) {
+        locks[i] = sample(rng);
+        index.insert(i, locks[i].data());
+    }
+    std::vector<std::vector<float>> queries(kQueries);
+    for (auto& query : queries) {
+        query = sample(rng);
+    }
+
+    bool pass = true;
+    const auto report = [&](const std::string& phase, float threshold) {
+        const RecallStats stats = measure_index_recall(index, locks, live, queries, threshold);
+        const bool ok = stats.found_hits == stats.true_hits;
+        pass = pass && ok;
+        const double scanned = index.size() == 0
+            ? 0.0 : static_cast<double>(stats.candidates) /
+                    static_cast<double>(index.size() * queries.size());
+        std::ostringstream oss;
+        oss << "  " << phase << " theta=" << std::fixed << std::setprecision(2) << threshold
+            << " buckets=" << index.bucket_count()
+            << " locks=" << index.size()
+            << " hits=" << stats.found_hits << "/" << stats.true_hits
+            << " scanned_fraction=" << std::setprecision(4) << scanned
+            << (ok ? " ok" : " MISSED CONFLICTS");
+        log_line(oss.str());
+    };
+
+    report("after-insert", 0.78f);
+    report("after-insert", 0.85f);
+    for (size_t i = 0; i < kLocks; ++i) {
+        if (rng() % 5 < 2) {
+            live[i] = false;
+            index.remove(i);
+        }
+    }
+    report("after-churn", 0.78f);
+    report("after-churn", 0.85f);
+
+    log_line(std::string("IVF-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
 }  // namespace
 
+// One holder blocks four waiters. Three of them are mutually clear; the
+// fourth, younger one overlaps the oldest. A single release should grant the
+// oldest waiter and both clear ones together, and leave only the younger
+// overlapping waiter queued.
+bool run_admission_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+    constexpr float kOffset = 0.6f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Admission-Check - a release grants a maximal clear set of waiters, oldest first");
+
+    const auto unit = [](std::vector<float> v) {
+        normalize_embedding(v);
+        return v;
+    };
+    std::vector<float> holder(kDim, 0.0f);
+    holder[0] = 1.0f;
+    // Arrival order: oldest first. Waiters 0 and 3 overlap each other.
+    std::vector<std::vector<float>> waiters(4, holder);
+    waiters[0][1] = kOffset;
+    waiters[1][2] = kOffset;
+    waiters[2][3] = kOffset;
+    waiters[3][1] = kOffset;
+    waiters[3][4] = 0.05f;
+    for (auto& waiter : waiters) {
+        waiter = unit(waiter);
+    }
+
+    ActiveLockTable table;
+    table.acquire("holder", holder, kTheta);
+    const auto start = Clock::now();
+    std::vector<Clock::time_point> granted(waiters.size());
+    std::vector<Clock::time_point> released(waiters.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            const std::string agent_id = "waiter-" + std::to_string(i);
+            table.acquire(agent_id, waiters[i], kTheta);
+            granted[i] = Clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            released[i] = Clock::now();
+            table.release(agent_id);
+        });
+        // Space the arrivals so their ages are unambiguous.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    table.release("holder");
+    const size_t granted_by_release = table.size();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const bool younger_waited = granted[3] >= released[0];
+    const bool pass = granted_by_release == 3 && younger_waited && table.size() == 0;
+    std::ostringstream oss;
+    oss << "  granted_by_one_release=" << granted_by_release << " (expected 3)"
+        << " younger_overlap_waited=" << (younger_waited ? "true" : "false")
+        << " elapsed_ms=" << std::fixed << std::setprecision(1)
+        << std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    log_line(oss.str());
+    log_line(std::string("Admission-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// A waiter's theta is set to exactly its similarity, under the table's own
+// kernel, to a lock granted while it waits. Arriving, that lock would block
+// it, so the release of its first holder must leave it waiting too, even
+// where the batch matrix rounds the pair below theta.
+bool run_admission_theta_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTries = 1000;
+
+    log_line("------------------------------------------------------------");
+    log_line("Admission-Theta-Check - a release decides a pair at theta like an arrival");
+
+    std::mt19937 rng(23);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    const auto random_unit = [&]() {
+        std::vector<float> v(kDim);
+        for (float& x : v) {
+            x = gauss(rng);
+        }
+        normalize_embedding(v);
+        return v;
+    };
+    const DotKernel dot = dot_kernel_for_dimension(kDim);
+    const std::vector<float> waiter = random_unit();
+    // Prefer a lock the matrix puts below the kernel's value.
+    std::vector<float> late;
+    float theta = 0.0f;
+    bool matrix_below = false;
+    for (size_t t = 0; t < kTries && !matrix_below; ++t) {
+        late = random_unit();
+        for (size_t i = 0; i < kDim; ++i) {
+            late[i] += 2.0f * waiter[i];
+        }
+        normalize_embedding(late);
+        theta = dot(waiter.data(), late.data(), kDim);
+        const float* rows[] = {waiter.data()};
+        const float* columns[] = {late.data(), waiter.data()};
+        float out[2];
+        dot_product_matrix(rows, 1, columns, 2, kDim, out);
+        matrix_below = out[0] < theta;
+    }
+
+    ActiveLockTable table;
+    table.acquire("holder", waiter, theta);
+    std::atomic<bool> granted{false};
+    std::thread thread([&]() {
+        granted = table.acquire("waiter", waiter, theta).status == AcquireStatus::kGranted;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    // Its own theta is out of reach of the holder, so it goes straight in.
+    const AcquireTrace late_trace = table.acquire("late", late, 0.999f);
+    table.release("holder");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const bool kept_waiting = !granted.load();
+    table.release("late");
+    thread.join();
+    const bool granted_after_release = granted.load();
+    table.release("waiter");
+
+    const bool pass = !late_trace.waited && kept_waiting && granted_after_release &&
+                      table.size() == 0;
+    std::ostringstream oss;
+    oss << std::boolalpha << "  theta=" << std::setprecision(9) << theta
+        << " matrix_below_theta=" << matrix_below << " kept_waiting=" << kept_waiting
+        << " granted_after_release=" << granted_after_release;
+    log_line(oss.str());
+    log_line(std::string("Admission-Theta-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// A holder blocks one waiter; two later arrivals overlap only the waiter.
+// Under overtake both go straight in, under FIFO each queues behind every
+// earlier waiter, and a bypass budget of one lets exactly the first through.
+bool run_queue_policy_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Queue-Check - arrivals must respect earlier waiters per queue policy");
+
+    std::vector<float> holder(kDim, 0.0f);
+    holder[0] = 1.0f;
+    std::vector<float> waiter = holder;
+    waiter[1] = 0.6f;
+    normalize_embedding(waiter);
+    std::vector<float> arrival(kDim, 0.0f);
+    arrival[0] = 0.6f;
+    arrival[1] = 1.0f;
+    normalize_embedding(arrival);
+
+    struct PolicyCase {
+        const char* name;
+        QueuePolicy policy;
+        std::vector<size_t> expect_position;
+    };
+    const std::vector<PolicyCase> cases = {
+        {"overtake", QueuePolicy::kOvertake, {0, 0}},
+        {"fifo", QueuePolicy::kFifo, {1, 2}},
+        {"bypass(1)", QueuePolicy::kBoundedBypass, {0, 1}},
+    };
+
+    bool pass = true;
+    for (const PolicyCase& policy_case : cases) {
+        ActiveLockTableOptions options;
+        options.queue_policy = policy_case.policy;
+        options.max_bypass = 1;
+        ActiveLockTable table(options);
+        table.acquire("holder", holder, kTheta);
+        std::thread waiter_thread([&]() {
+            table.acquire("waiter", waiter, kTheta);
+            table.release("waiter");
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+        std::vector<AcquireTrace> traces(policy_case.expect_position.size());
+        std::vector<std::thread> arrivals;
+        for (size_t i = 0; i < traces.size(); ++i) {
+            arrivals.emplace_back([&, i]() {
+                const std::string agent_id = "arrival-" + std::to_string(i);
+                traces[i] = table.acquire(agent_id, arrival, kTheta);
+                table.release(agent_id);
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+        table.release("holder");
+        waiter_thread.join();
+        for (auto& thread : arrivals) {
+            thread.join();
+        }
+
+        bool ok = table.size() == 0;
+        std::ostringstream oss;
+        oss << "  " << policy_case.name;
+        for (size_t i = 0; i < traces.size(); ++i) {
+            const size_t expected = policy_case.expect_position[i];
+            ok = ok && traces[i].waited == (expected > 0) &&
+                 traces[i].queue_position == expected;
+            oss << " arrival-" << i << "{waited=" << (traces[i].waited ? "true" : "false")
+                << " queue_position=" << traces[i].queue_position << "}";
+        }
+        oss << (ok ? " ok" : " UNEXPECTED");
+        log_line(oss.str());
+        pass = pass && ok;
+    }
+
+    log_line(std::string("Queue-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Two readers share a region, then a writer waits for them and a third
+// reader arrives. With writer preference the reader queues behind the
+// writer; without it the reader joins the other two and the writer waits on.
+bool run_shared_mode_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Shared-Check - readers share a region, writers exclude them and are not starved");
+
+    std::vector<float> region(kDim, 0.0f);
+    region[0] = 1.0f;
+
+    bool pass = true;
+    for (const bool writer_preference : {true, false}) {
+        ActiveLockTableOptions options;
+        options.writer_preference = writer_preference;
+        ActiveLockTable table(options);
+        const AcquireTrace first = table.acquire("reader-1", region, kTheta, LockMode::kShared);
+        const AcquireTrace second = table.acquire("reader-2", region, kTheta, LockMode::kShared);
+
+        std::atomic<int> grants{0};
+        int writer_order = -1;
+        int reader_order = -1;
+        AcquireTrace writer_trace;
+        AcquireTrace reader_trace;
+        std::thread writer([&]() {
+            writer_trace = table.acquire("writer", region, kTheta);
+            writer_order = grants++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            table.release("writer");
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        std::thread reader([&]() {
+            reader_trace = table.acquire("reader-3", region, kTheta, LockMode::kShared);
+            reader_order = grants++;
+            table.release("reader-3");
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        table.release("reader-1");
+        table.release("reader-2");
+        writer.join();
+        reader.join();
+
+        const bool ok =
+            !first.waited && !second.waited && writer_trace.waited && table.size() == 0 &&
+            (writer_preference
+                 ? reader_trace.waited && reader_trace.queue_position == 1 &&
+                       writer_order < reader_order
+                 : !reader_trace.waited && reader_order < writer_order);
+        std::ostringstream oss;
+        oss << "  writer_preference=" << (writer_preference ? "on " : "off")
+            << " readers_shared=" << (!first.waited && !second.waited ? "true" : "false")
+            << " late_reader{waited=" << (reader_trace.waited ? "true" : "false")
+            << " queue_position=" << reader_trace.queue_position << "}"
+            << " writer_first=" << (writer_order < reader_order ? "true" : "false")
+            << (ok ? " ok" : " UNEXPECTED");
+        log_line(oss.str());
+        pass = pass && ok;
+    }
+
+    log_line(std::string("Shared-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Bands of {0.85: 2 holders, 0.78: 4 holders} below theta 0.95. The request
+// fits beside one near holder or three loose ones, waits when a band is
+// full, and goes in once a holder from the full band leaves.
+bool run_concurrency_band_check() {
+    constexpr size_t kDim = 16;
+    constexpr float kTheta = 0.95f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Band-Check - graded holder limits per similarity band");
+
+    ActiveLockTableOptions options;
+    options.concurrency_bands = {{0.85f, 2}, {0.78f, 4}};
+    // Unit vectors at `along` from axis 0, each on its own second axis so
+    // holders stay apart from one another.
+    const auto holder = [](float along, size_t axis) {
+        std::vector<float> v(kDim, 0.0f);
+        v[0] = along;
+        v[axis] = std::sqrt(1.0f - along * along);
+        return v;
+    };
+    std::vector<float> query(kDim, 0.0f);
+    query[0] = 1.0f;
+    const auto fits = [&query](ActiveLockTable& table) {
+        const AcquireTrace trace = table.acquire_until(
+            "probe", query, kTheta,
+            ActiveLockTable::Clock::now() + std::chrono::milliseconds(20));
+        table.release("probe");
+        return trace.status == AcquireStatus::kGranted && !trace.waited;
+    };
+
+    ActiveLockTable near_table(options);
+    near_table.acquire("near-1", holder(0.90f, 1), kTheta);
+    const bool near_one_fits = fits(near_table);
+    near_table.acquire("near-2", holder(0.90f, 2), kTheta);
+    const bool near_two_full = !fits(near_table);
+    near_table.release("near-2");
+    near_table.acquire("duplicate", query, kTheta);
+    const bool duplicate_waits = !fits(near_table);
+
+    ActiveLockTable loose_table(options);
+    for (size_t i = 1; i <= 3; ++i) {
+        loose_table.acquire("loose-" + std::to_string(i), holder(0.80f, i), kTheta);
+    }
+    const bool loose_three_fit = fits(loose_table);
+    loose_table.acquire("loose-4", holder(0.82f, 4), kTheta);
+    std::atomic<bool> granted{false};
+    std::thread waiter([&]() {
+        granted = loose_table.acquire("waiter", query, kTheta).status == AcquireStatus::kGranted;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const bool loose_four_full = !granted.load();
+    loose_table.release("loose-4");
+    waiter.join();
+    const bool admitted_after_release = granted.load();
+
+    const bool pass = near_one_fits && near_two_full && duplicate_waits && loose_three_fit &&
+                      loose_four_full && admitted_after_release;
+    std::ostringstream oss;
+    oss << std::boolalpha << "  near{1_fits=" << near_one_fits << " 2_full=" << near_two_full
+        << " duplicate_waits=" << duplicate_waits << "} loose{3_fit=" << loose_three_fit
+        << " 4_full=" << loose_four_full << " admitted_after_release=" << admitted_after_release
+        << "}";
+    log_line(oss.str());
+    log_line(std::string("Band-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// A set {A, B} waits on a holder of A without taking B, is granted whole
+// once A is free, and is dropped by one release. Agents then take
+// overlapping sets in opposite orders, which must never deadlock.
+bool run_multi_vector_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+    constexpr size_t kRounds = 25;
+
+    log_line("------------------------------------------------------------");
+    log_line("Multi-Check - embedding sets are granted all or nothing");
+
+    const auto axis = [](size_t index) {
+        std::vector<float> v(kDim, 0.0f);
+        v[index] = 1.0f;
+        return v;
+    };
+    const std::vector<std::vector<float>> set = {axis(0), axis(1)};
+    const auto free_now = [](ActiveLockTable& table, const std::vector<float>& embedding) {
+        const AcquireTrace trace = table.acquire_until(
+            "probe", embedding, kTheta,
+            ActiveLockTable::Clock::now() + std::chrono::milliseconds(20));
+        table.release("probe");
+        return trace.status == AcquireStatus::kGranted && !trace.waited;
+    };
+
+    ActiveLockTable table;
+    table.acquire("holder", set[0], kTheta);
+    std::atomic<bool> granted{false};
+    std::thread taker([&]() {
+        const AcquireTrace trace = table.acquire_all_until(
+            "set", set, kTheta, ActiveLockTable::Clock::time_point::max());
+        granted = trace.status == AcquireStatus::kGranted;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const bool nothing_taken = !granted.load() && free_now(table, set[1]);
+    table.release("holder");
+    taker.join();
+    const bool whole_set = granted.load() && table.size() == 2 && !free_now(table, set[1]);
+    table.release("set");
+    const bool one_release = table.size() == 0;
+
+    // Opposite orders of the same two regions.
+    const std::vector<std::vector<float>> reversed = {set[1], set[0]};
+    std::atomic<size_t> grants{0};
+    std::vector<std::thread> agents;
+    for (size_t a = 0; a < 4; ++a) {
+        agents.emplace_back([&, a]() {
+            const std::string agent_id = "agent-" + std::to_string(a);
+            for (size_t round = 0; round < kRounds; ++round) {
+                const AcquireTrace trace =
+                    table.acquire_all_until(agent_id, a % 2 == 0 ? set : reversed, kTheta,
+                                            ActiveLockTable::Clock::time_point::max());
+                if (trace.status == AcquireStatus::kGranted) {
+                    ++grants;
+                }
+                table.release(agent_id);
+            }
+        });
+    }
+    for (auto& agent : agents) {
+        agent.join();
+    }
+    const bool no_deadlock = grants.load() == 4 * kRounds && table.size() == 0;
+
+    const bool pass = nothing_taken && whole_set && one_release && no_deadlock;
+    std::ostringstream oss;
+    oss << std::boolalpha << "  nothing_taken_while_waiting=" << nothing_taken
+        << " whole_set_granted=" << whole_set << " one_release=" << one_release
+        << " crossed_sets_granted=" << grants.load() << "/" << 4 * kRounds;
+    log_line(oss.str());
+    log_line(std::string("Multi-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// A burst of readers on one region shares a cluster cap. Exclusive probes
+// far from it skip every reader on the cap alone; probes around theta must
+// reach the same decision as a check against each reader.
+bool run_cluster_check() {
+    constexpr size_t kDim = 32;
+    constexpr float kTheta = 0.85f;
+    constexpr size_t kReaders = 24;
+
+    log_line("------------------------------------------------------------");
+    log_line("Cluster-Check - near-identical locks share a cap the scans test first");
+
+    std::mt19937 rng(41);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    ActiveLockTableOptions options;
+    options.cluster_similarity = 0.98f;
+    ActiveLockTable table(options);
+    std::vector<std::vector<float>> readers;
+    for (size_t i = 0; i < kReaders; ++i) {
+        std::vector<float> v(kDim, 0.0f);
+        v[0] = 1.0f;
+        for (float& value : v) {
+            value += noise(rng);
+        }
+        normalize_embedding(v);
+        table.acquire("reader-" + std::to_string(i), v, kTheta, LockMode::kShared);
+        readers.push_back(std::move(v));
+    }
+
+    // Far probes on other axes, then probes closing in on the readers.
+    std::vector<std::vector<float>> probes;
+    for (size_t axis = 1; axis <= 4; ++axis) {
+        std::vector<float> v(kDim, 0.0f);
+        v[axis] = 1.0f;
+        probes.push_back(std::move(v));
+    }
+    for (const float along : {0.80f, 0.84f, 0.86f, 0.88f, 1.0f}) {
+        std::vector<float> v(kDim, 0.0f);
+        v[0] = along;
+        v[1] = std::sqrt(1.0f - along * along);
+        probes.push_back(std::move(v));
+    }
+    const ClusterScanStats before = table.cluster_scan_stats();
+    size_t wrong = 0;
+    for (size_t p = 0; p < probes.size(); ++p) {
+        bool expected_blocked = false;
+        for (const auto& reader : readers) {
+            expected_blocked =
+                expected_blocked || dot_product(probes[p].data(), reader.data(), kDim) >= kTheta;
+        }
+        const std::string agent_id = "probe-" + std::to_string(p);
+        const AcquireTrace trace = table.acquire_for(agent_id, probes[p], kTheta,
+                                                     std::chrono::milliseconds(5));
+        const bool blocked = trace.status != AcquireStatus::kGranted;
+        if (!blocked) {
+            table.release(agent_id);
+        }
+        wrong += blocked != expected_blocked ? 1 : 0;
+    }
+    const ClusterScanStats after = table.cluster_scan_stats();
+    const uint64_t skipped = after.rows_skipped - before.rows_skipped;
+
+    for (size_t i = 0; i < kReaders; ++i) {
+        table.release("reader-" + std::to_string(i));
+    }
+    const bool pass = wrong == 0 && skipped >= 4 * (kReaders - 1) && table.size() == 0;
+    std::ostringstream oss;
+    oss << "  readers=" << kReaders << " probes=" << probes.size()
+        << " wrong_decisions=" << wrong << " caps_checked="
+        << after.caps_checked - before.caps_checked << " rows_skipped=" << skipped;
+    log_line(oss.str());
+    log_line(std::string("Cluster-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Timers spread across every wheel level, and past its span, each fire on
+// the first advance that reaches their tick. Then a holder keeps its lease
+// alive with heartbeats while a conflicting waiter stays blocked, stops
+// renewing, and the reaper hands the region to the waiter.
+bool run_lease_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+    constexpr size_t kTimers = 2000;
+
+    log_line("------------------------------------------------------------");
+    log_line("Lease-Check - leases expire on the timer wheel and free only their waiters");
+
+    std::mt19937 rng(43);
+    TimerWheel wheel(5);
+    std::vector<uint64_t> due(kTimers);
+    for (size_t key = 0; key < kTimers; ++key) {
+        due[key] = 6 + rng() % (uint64_t{1} << (TimerWheel::kSlotBits * (key % 5 + 1)));
+        wheel.schedule(key, due[key]);
+    }
+    // Half the steps jump straight to next_tick(), as the reaper does; no
+    // timer may be due before it.
+    size_t late_or_early = 0;
+    size_t fired_count = 0;
+    std::vector<uint64_t> fired;
+    uint64_t tick = 5;
+    while (!wheel.empty()) {
+        const uint64_t previous = tick;
+        const uint64_t next = wheel.next_tick();
+        tick = rng() % 2 == 0 ? next : tick + 1 + rng() % 5000;
+        fired.clear();
+        wheel.advance(tick, fired);
+        for (const uint64_t key : fired) {
+            late_or_early += due[key] > tick || due[key] <= previous || due[key] < next ? 1 : 0;
+        }
+        fired_count += fired.size();
+    }
+    const bool wheel_ok = late_or_early == 0 && fired_count == kTimers;
+
+    std::vector<float> region(kDim, 0.0f);
+    region[0] = 1.0f;
+    std::vector<float> elsewhere(kDim, 0.0f);
+    elsewhere[1] = 1.0f;
+    ActiveLockTableOptions options;
+    options.lease_tick = std::chrono::milliseconds(2);
+    ActiveLockTable table(options);
+    const auto ttl = std::chrono::milliseconds(60);
+    const AcquireTrace holder = table.acquire("holder", region, kTheta);
+    const AcquireTrace bystander = table.acquire("bystander", elsewhere, kTheta);
+    // Only a lease can be renewed, and only locks still held can be leased.
+    const bool leased = !table.renew_lease("holder", ttl) &&
+                        table.lease_locks("holder", holder.lock_ids, ttl) &&
+                        table.renew_lease("holder", ttl) && !table.renew_lease("nobody", ttl);
+
+    // A later call from the same agent without a lease releases only the
+    // lock it was granted; the leased one stays, lease and all.
+    std::vector<float> aside(kDim, 0.0f);
+    aside[2] = 1.0f;
+    const AcquireTrace call = table.acquire("holder", aside, kTheta);
+    table.release("holder", call.lock_ids);
+    const bool scoped_release = call.lock_ids.size() == 1 && table.size() == 2 &&
+                                table.renew_lease("holder", ttl) &&
+                                !table.lease_locks("holder", call.lock_ids, ttl);
+
+    // Another call without a lease is still mid-write when the lease runs
+    // out: its lock must outlive the lease.
+    const AcquireTrace in_flight = table.acquire("holder", aside, kTheta);
+    std::atomic<bool> granted{false};
+    std::thread waiter([&]() {
+        granted = table.acquire("waiter", region, kTheta).status == AcquireStatus::kGranted;
+    });
+    bool renewed = true;
+    for (size_t beat = 0; beat < 6; ++beat) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        renewed = renewed && table.renew_lease("holder", ttl);
+    }
+    const bool held_by_heartbeats = renewed && !granted.load();
+    waiter.join();
+    const bool expired = granted.load() && !table.renew_lease("holder", ttl) &&
+                         table.size() == 3;
+    const AcquireTrace rival = table.acquire_until(
+        "rival", aside, kTheta, ActiveLockTable::Clock::now() + std::chrono::milliseconds(20));
+    table.release("holder", in_flight.lock_ids);
+    const bool in_flight_kept = rival.status == AcquireStatus::kDeadlineExceeded &&
+                                table.size() == 2;
+    table.release("waiter");
+    // Releasing the agent outright ends its lease too.
+    table.lease_locks("bystander", bystander.lock_ids, ttl);
+    table.release("bystander");
+    const bool release_ends_lease = !table.renew_lease("bystander", ttl);
+    const bool pass = wheel_ok && leased && scoped_release && held_by_heartbeats && expired &&
+                      in_flight_kept && release_ends_lease && table.size() == 0;
+
+    std::ostringstream oss;
+    oss << std::boolalpha << "  wheel{timers=" << kTimers << " fired=" << fired_count
+        << " off_tick=" << late_or_early << "} leased=" << leased
+        << " scoped_release=" << scoped_release
+        << " held_by_heartbeats=" << held_by_heartbeats
+        << " waiter_granted_on_expiry=" << expired
+        << " unleased_lock_kept=" << in_flight_kept
+        << " release_ends_lease=" << release_ends_lease;
+    log_line(oss.str());
+    log_line(std::string("Lease-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Three conflicting waiters queue behind a holder: one without a deadline,
+// one with a generous deadline, and one whose deadline passes before the
+// holder leaves. The release must shed the expired one and grant the one
+// with a deadline ahead of the older one without.
+bool run_deadline_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Deadline-Check - earliest deadline is granted first, expired waiters are shed");
+
+    std::vector<float> embedding(kDim, 1.0f);
+    normalize_embedding(embedding);
+    ActiveLockTable table;
+    table.acquire("holder", embedding, kTheta);
+
+    const ActiveLockTable::Clock::time_point now = ActiveLockTable::Clock::now();
+    const std::vector<std::string> names = {"no-deadline", "deadline-1s", "deadline-50ms"};
+    const std::vector<ActiveLockTable::Clock::time_point> deadlines = {
+        ActiveLockTable::Clock::time_point::max(),
+        now + std::chrono::seconds(1),
+        now + std::chrono::milliseconds(50)};
+    std::vector<AcquireTrace> traces(names.size());
+    std::vector<Clock::time_point> granted(names.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < names.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            traces[i] = table.acquire_until(names[i], embedding, kTheta, deadlines[i]);
+            granted[i] = Clock::now();
+            if (traces[i].status == AcquireStatus::kGranted) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                table.release(names[i]);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    table.release("holder");
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const AcquireTrace late = table.acquire_until("already-late", embedding, kTheta, now);
+    // A short deadline alone is no reason to shed an uncontended request.
+    const AcquireTrace short_deadline = table.acquire_until(
+        "short-deadline", embedding, kTheta,
+        ActiveLockTable::Clock::now() + std::chrono::milliseconds(100));
+    const bool short_granted =
+        short_deadline.status == AcquireStatus::kGranted && !short_deadline.waited;
+    table.release("short-deadline");
+
+    const bool edf_order = traces[0].status == AcquireStatus::kGranted &&
+                           traces[1].status == AcquireStatus::kGranted &&
+                           granted[1] < granted[0];
+    const bool expired_shed = traces[2].status == AcquireStatus::kDeadlineExceeded;
+    const bool late_shed = late.status == AcquireStatus::kDeadlineExceeded;
+    const bool pass =
+        edf_order && expired_shed && late_shed && short_granted && table.size() == 0;
+    std::ostringstream oss;
+    oss << "  deadline_granted_first=" << (edf_order ? "true" : "false")
+        << " expired_waiter_shed=" << (expired_shed ? "true" : "false")
+        << " late_arrival_shed=" << (late_shed ? "true" : "false")
+        << " uncontended_100ms_granted=" << (short_granted ? "true" : "false");
+    log_line(oss.str());
+    log_line(std::string("Deadline-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Waiters that time out or are cancelled must leave the table cleanly:
+// under FIFO, an arrival queued only behind a cancelled waiter goes in while
+// the holder still holds its lock.
+bool run_cancellation_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Cancel-Check - timed-out and cancelled waiters leave the table");
+
+    std::vector<float> holder(kDim, 0.0f);
+    holder[0] = 1.0f;
+    std::vector<float> waiter = holder;
+    waiter[1] = 0.6f;
+    normalize_embedding(waiter);
+    std::vector<float> arrival(kDim, 0.0f);
+    arrival[0] = 0.6f;
+    arrival[1] = 1.0f;
+    normalize_embedding(arrival);
+
+    ActiveLockTableOptions options;
+    options.queue_policy = QueuePolicy::kFifo;
+    ActiveLockTable table(options);
+    table.acquire("holder", holder, kTheta);
+
+    const AcquireTrace timed =
+        table.acquire_for("timed", waiter, kTheta, std::chrono::milliseconds(60));
+
+    std::atomic<bool> cancel{false};
+    AcquireTrace cancelled;
+    std::thread cancelled_thread([&]() {
+        cancelled = table.acquire_until("cancelled", waiter, kTheta,
+                                        ActiveLockTable::Clock::time_point::max(),
+                                        [&cancel]() { return cancel.load(); });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    AcquireTrace queued;
+    std::thread queued_thread([&]() {
+        queued = table.acquire("queued", arrival, kTheta);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    cancel = true;
+    cancelled_thread.join();
+    queued_thread.join();
+    const size_t active_with_holder = table.size();
+    table.release("queued");
+    table.release("holder");
+
+    const bool timed_ok = timed.status == AcquireStatus::kDeadlineExceeded;
+    const bool cancelled_ok = cancelled.status == AcquireStatus::kCancelled;
+    const bool queued_ok = queued.status == AcquireStatus::kGranted && queued.queue_position == 1;
+    const bool pass = timed_ok && cancelled_ok && queued_ok && active_with_holder == 2 &&
+                      table.size() == 0;
+    std::ostringstream oss;
+    oss << "  timed_out=" << (timed_ok ? "true" : "false")
+        << " cancelled=" << (cancelled_ok ? "true" : "false")
+        << " follower_granted_after_cancel=" << (queued_ok ? "true" : "false")
+        << " active_with_holder=" << active_with_holder << " (expected 2)";
+    log_line(oss.str());
+    log_line(std::string("Cancel-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Pivot pruning may only skip rows that cannot conflict: every query must
+// be blocked exactly when a brute-force scan finds a lock at or above theta.
+bool run_pivot_pruning_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 12;
+    // Kept small: every grant logs the whole active lock list.
+    constexpr size_t kLocks = 300;
+    constexpr size_t kQueries = 150;
+    constexpr float kInsertTheta = 0.97f;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Pivot-Check - pivot angle bounds must never skip a conflicting lock");
+
+    std::mt19937 rng(29);
+    TopicSampler sample(kDim, kTopics, rng);
+    ActiveLockTableOptions options;
+    options.pivot_count = 16;
+    ActiveLockTable table(options);
+    const auto timeout = std::chrono::milliseconds(1);
+
+    std::vector<std::vector<float>> locks;
+    for (size_t i = 0; i < kLocks; ++i) {
+        std::vector<float> v = sample(rng);
+        const std::string agent_id = "pivot-lock-" + std::to_string(i);
+        if (table.acquire_for(agent_id, v, kInsertTheta, timeout).status ==
+            AcquireStatus::kGranted) {
+            locks.push_back(std::move(v));
+        }
+    }
+
+    const PivotPruningStats before = table.pivot_pruning_stats();
+    size_t conflicts = 0;
+    size_t wrong = 0;
+    for (size_t q = 0; q < kQueries; ++q) {
+        const std::vector<float> query = sample(rng);
+        bool expected_blocked = false;
+        for (const auto& lock : locks) {
+            if (dot_product(query.data(), lock.data(), kDim) >= kTheta) {
+                expected_blocked = true;
+                break;
+            }
+        }
+        const std::string agent_id = "pivot-query-" + std::to_string(q);
+        const AcquireTrace trace = table.acquire_for(agent_id, query, kTheta, timeout);
+        const bool blocked = trace.status != AcquireStatus::kGranted;
+        if (!blocked) {
+            table.release(agent_id);
+        }
+        conflicts += expected_blocked ? 1 : 0;
+        wrong += blocked != expected_blocked ? 1 : 0;
+    }
+    const PivotPruningStats after = table.pivot_pruning_stats();
+    const uint64_t considered = after.rows_considered - before.rows_considered;
+    const uint64_t pruned = after.rows_pruned - before.rows_pruned;
+
+    const bool pass = wrong == 0 && considered > 0;
+    std::ostringstream oss;
+    oss << "  dim=" << kDim << " locks=" << locks.size() << " queries=" << kQueries
+        << " conflicting=" << conflicts << " wrong_decisions=" << wrong
+        << " pruning_rate=" << std::fixed << std::setprecision(3)
+        << (considered > 0 ? static_cast<double>(pruned) / considered : 0.0);
+    log_line(oss.str());
+    log_line(std::string("Pivot-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Without diagnostics, parallel scans stop at the first conflict they find.
+// The request must still wait out every conflicting lock, not just the one
+// that stopped the scan.
+bool run_parallel_scan_check() {
+    constexpr size_t kDim = 384;
+    constexpr size_t kTopics = 12;
+    // Kept small: every grant logs the whole active lock list.
+    constexpr size_t kLocks = 300;
+    constexpr size_t kQueries = 100;
+    constexpr float kInsertTheta = 0.97f;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Parallel-Check - early-stopping parallel scans still honour every conflict");
+
+    std::mt19937 rng(31);
+    TopicSampler sample(kDim, kTopics, rng);
+    ActiveLockTableOptions options;
+    options.parallel_scan_threads = 3;
+    options.parallel_scan_min_locks = 64;
+    ActiveLockTable table(options);
+    const auto timeout = std::chrono::milliseconds(1);
+
+    // Two near-duplicates far apart in the table, so different partitions
+    // find them.
+    std::vector<float> twin_a = sample(rng);
+    std::vector<float> twin_b = twin_a;
+    twin_b[0] += 0.05f;
+    normalize_embedding(twin_b);
+    table.acquire("twin-a", twin_a, 0.9999f);
+    std::vector<std::vector<float>> locks = {twin_a};
+    for (size_t i = 0; i < kLocks; ++i) {
+        std::vector<float> v = sample(rng);
+        const std::string agent_id = "parallel-lock-" + std::to_string(i);
+        if (table.acquire_for(agent_id, v, kInsertTheta, timeout).status ==
+            AcquireStatus::kGranted) {
+            locks.push_back(std::move(v));
+        }
+    }
+    table.acquire("twin-b", twin_b, 0.9999f);
+    locks.push_back(twin_b);
+
+    size_t conflicts = 0;
+    size_t wrong = 0;
+    for (size_t q = 0; q < kQueries; ++q) {
+        const std::vector<float> query = sample(rng);
+        bool expected_blocked = false;
+        for (const auto& lock : locks) {
+            expected_blocked = expected_blocked ||
+                               dot_product(query.data(), lock.data(), kDim) >= kTheta;
+        }
+        const std::string agent_id = "parallel-query-" + std::to_string(q);
+        const AcquireTrace trace = table.acquire_until(
+            agent_id, query, kTheta, ActiveLockTable::Clock::now() + timeout, {}, false);
+        const bool blocked = trace.status != AcquireStatus::kGranted;
+        if (!blocked) {
+            table.release(agent_id);
+        }
+        conflicts += expected_blocked ? 1 : 0;
+        wrong += blocked != expected_blocked ? 1 : 0;
+    }
+
+    // A copy of the twins conflicts with both: releasing one must not let it in.
+    std::atomic<bool> granted{false};
+    std::thread waiter([&]() {
+        const AcquireTrace trace = table.acquire_until(
+            "twin-reader", twin_a, 0.99f, ActiveLockTable::Clock::time_point::max(), {}, false);
+        granted = trace.status == AcquireStatus::kGranted;
+        table.release("twin-reader");
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    table.release("twin-a");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const bool held_by_second = !granted.load();
+    table.release("twin-b");
+    waiter.join();
+
+    const bool pass = wrong == 0 && held_by_second && granted.load();
+    std::ostringstream oss;
+    oss << "  locks=" << locks.size() << " queries=" << kQueries
+        << " conflicting=" << conflicts << " wrong_decisions=" << wrong
+        << " waited_for_both_twins=" << (held_by_second && granted.load() ? "true" : "false");
+    log_line(oss.str());
+    log_line(std::string("Parallel-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
+// Without diagnostics an acquire names the first conflict it meets; with them
+// it names the most similar one. Either way it waits for both.
+bool run_diagnostics_check() {
+    constexpr size_t kDim = 8;
+    constexpr float kTheta = 0.85f;
+
+    log_line("------------------------------------------------------------");
+    log_line("Diagnostics-Check - first-conflict scans stay correct, full scans name the strongest blocker");
+
+    const auto unit = [](float along, size_t axis) {
+        std::vector<float> v(kDim, 0.0f);
+        v[0] = along;
+        v[axis] = std::sqrt(1.0f - along * along);
+        return v;
+    };
+    const std::vector<float> query = unit(1.0f, 1);
+    ActiveLockTable table;
+    table.acquire("weaker", unit(0.90f, 1), 0.95f);
+    table.acquire("stronger", unit(0.99f, 2), 0.95f);
+
+    const auto soon = [] { return ActiveLockTable::Clock::now() + std::chrono::milliseconds(1); };
+    const AcquireTrace fast = table.acquire_until("fast", query, kTheta, soon(), {}, false);
+    const AcquireTrace full = table.acquire_until("full", query, kTheta, soon(), {}, true);
+
+    std::atomic<bool> granted{false};
+    std::thread waiter([&]() {
+        const AcquireTrace trace = table.acquire_until(
+            "fast-waiter", query, kTheta, ActiveLockTable::Clock::time_point::max(), {}, false);
+        granted = trace.status == AcquireStatus::kGranted;
+        table.release("fast-waiter");
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    table.release("weaker");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const bool held_by_second = !granted.load();
+    table.release("stronger");
+    waiter.join();
+
+    const bool pass = fast.waited && fast.blocking_agent_id == "weaker" &&
+                      full.waited && full.blocking_agent_id == "stronger" &&
+                      held_by_second && granted.load() && table.size() == 0;
+    std::ostringstream oss;
+    oss << "  first_conflict=" << fast.blocking_agent_id << std::fixed << std::setprecision(2)
+        << "(" << fast.blocking_similarity_score << ")"
+        << " strongest=" << full.blocking_agent_id << "(" << full.blocking_similarity_score << ")"
+        << " waited_for_both=" << (held_by_second && granted.load() ? "true" : "false");
+    log_line(oss.str());
+    log_line(std::string("Diagnostics-Check result: ") + (pass ? "PASS" : "FAIL"));
+    log_line("");
+    return pass;
+}
+
 int main() {
     constexpr size_t kThreads = 5;
     constexpr size_t kDim = 8;
@@ -256,8 +1731,30 @@ int main() {
         kThreads, std::vector<float>(kDim, 1.0f));
     for (size_t i = 0; i < kThreads; ++i) {
         conflict_embeddings[i][0] += static_cast<float>(i) * 0.0001f;
+        normalize_embedding(conflict_embeddings[i]);
     }
 
+    const bool kernels_ok = run_kernel_accuracy_check();
+    const bool dimension_ok = run_dimension_lock_check();
+    const bool hnsw_ok = run_hnsw_recall_check();
+    const bool ivf_ok = run_ivf_exactness_check();
+    const bool quantized_ok = run_quantized_prefilter_check();
+    const bool half_ok = run_half_precision_check();
+    const bool shards_ok = run_shard_probe_check();
+    const bool pivots_ok = run_pivot_pruning_check();
+    const bool parallel_ok = run_parallel_scan_check();
+    const bool diagnostics_ok = run_diagnostics_check();
+    const bool admission_ok = run_admission_check();
+    const bool admission_theta_ok = run_admission_theta_check();
+    const bool queue_ok = run_queue_policy_check();
+    const bool shared_ok = run_shared_mode_check();
+    const bool bands_ok = run_concurrency_band_check();
+    const bool multi_ok = run_multi_vector_check();
+    const bool cluster_ok = run_cluster_check();
+    const bool lease_ok = run_lease_check();
+    const bool deadline_ok = run_deadline_check();
+    const bool cancel_ok = run_cancellation_check();
+
     const TestOutcome test_a = run_case(
         "Scenario-1",
         no_conflict_embeddings,
@@ -274,7 +1771,23 @@ int main() {
         "Nearly identical embeddings (semantic conflict)",
         "only one agent should be active at a time");
 
-    const bool overall_pass = test_a.pass && test_b.pass;
+    ActiveLockTableOptions sharded;
+    sharded.shard_bits = 3;
+    const TestOutcome test_c = run_case(
+        "Scenario-3",
+        conflict_embeddings,
+        kTheta,
+        true,
+        "Nearly identical embeddings on an 8-shard table",
+        "only one agent should be active at a time",
+        sharded);
+
+    const bool overall_pass = kernels_ok && dimension_ok && hnsw_ok && ivf_ok && quantized_ok &&
+                              half_ok && shards_ok && pivots_ok && parallel_ok &&
+                              diagnostics_ok &&
+                              admission_ok && admission_theta_ok && queue_ok && shared_ok && bands_ok && multi_ok &&
+                              cluster_ok && lease_ok && deadline_ok && cancel_ok &&
+                              test_a.pass && test_b.pass && test_c.pass;
     std::cout << "Final summary: " << (overall_pass ? "PASS" : "FAIL") << std::endl;
 
     return overall_pass ? 0 : 1;
@@ -0,0 +1,88 @@
+// Implements the hierarchical timer wheel behind lock lease expiry.
+// A timer on level k is less than 64^(k+1) ticks away and sits in the slot
+// of its level-k digit, which the current tick reaches just before it is due.
+
+#include "timer_wheel.h"
+
+#include <limits>
+#include <utility>
+
+TimerWheel::TimerWheel(uint64_t start_tick) : current_(start_tick) {}
+
+void TimerWheel::schedule(uint64_t key, uint64_t due_tick) {
+    place(Timer{key, due_tick});
+    ++size_;
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<uint64_t>& fired) {
+    while (current_ < tick && size_ > due_.size()) {
+        ++current_;
+        // Every level whose lower digits just wrapped to zero turns one slot.
+        for (size_t level = 1; level < kLevels; ++level) {
+            const uint64_t lower = (uint64_t{1} << (kSlotBits * level)) - 1;
+            if ((current_ & lower) != 0) {
+                break;
+            }
+            cascade(level, static_cast<size_t>((current_ >> (kSlotBits * level)) & (kSlots - 1)));
+        }
+        cascade(0, static_cast<size_t>(current_ & (kSlots - 1)));
+    }
+    if (current_ < tick) {
+        current_ = tick;
+    }
+    for (const Timer& timer : due_) {
+        fired.push_back(timer.key);
+    }
+    size_ -= due_.size();
+    due_.clear();
+}
+
+uint64_t TimerWheel::next_tick() const {
+    if (!due_.empty()) {
+        return current_;
+    }
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (size_t level = 0; level < kLevels; ++level) {
+        // Level k turns one slot every 64^k ticks; a full turn visits every
+        // slot, including the current one, which holds only far timers.
+        const size_t shift = kSlotBits * level;
+        for (uint64_t step = 1; step <= kSlots; ++step) {
+            const uint64_t reached = ((current_ >> shift) + step) << shift;
+            if (reached >= next) {
+                break;
+            }
+            if (!slots_[level][(reached >> shift) & (kSlots - 1)].empty()) {
+                next = reached;
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+void TimerWheel::place(const Timer& timer) {
+    if (timer.due <= current_) {
+        due_.push_back(timer);
+        return;
+    }
+    const uint64_t distance = timer.due - current_;
+    for (size_t level = 0; level < kLevels; ++level) {
+        if (distance < (uint64_t{1} << (kSlotBits * (level + 1)))) {
+            slots_[level][(timer.due >> (kSlotBits * level)) & (kSlots - 1)].push_back(timer);
+            return;
+        }
+    }
+    // Beyond the wheel: park in the farthest top-level slot, which is
+    // reached before the timer is due.
+    constexpr size_t top = kLevels - 1;
+    const uint64_t farthest = current_ + (uint64_t{1} << (kSlotBits * kLevels)) - 1;
+    slots_[top][(farthest >> (kSlotBits * top)) & (kSlots - 1)].push_back(timer);
+}
+
+void TimerWheel::cascade(size_t level, size_t slot) {
+    std::vector<Timer> timers;
+    timers.swap(slots_[level][slot]);
+    for (const Timer& timer : timers) {
+        place(timer);
+    }
+}
@@ -0,0 +1,64 @@
+// Declares the hierarchical timer wheel behind lock lease expiry.
+// Timers sit in one of kLevels rings of 64 slots by how far away they are due,
+// and move down a level each time the ring above them turns over.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Counts time in whole ticks; the caller picks the tick length. Scheduling
+// and firing a timer are O(1), plus one move per level it cascades through.
+// Not thread-safe.
+class TimerWheel {
+public:
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    // 2^24 ticks; timers due later park in the top level and are placed
+    // again each time they come round.
+    static constexpr size_t kLevels = 4;
+
+    explicit TimerWheel(uint64_t start_tick = 0);
+
+    // A timer due at or before the current tick fires on the next advance.
+    // The same key may be scheduled more than once; each timer fires on its
+    // own.
+    void schedule(uint64_t key, uint64_t due_tick);
+
+    // Moves the wheel forward to `tick` and appends the key of every timer
+    // due by then to `fired`, in no particular order. An empty wheel jumps
+    // straight there.
+    void advance(uint64_t tick, std::vector<uint64_t>& fired);
+
+    uint64_t current_tick() const { return current_; }
+
+    // The first tick an advance has to reach before any timer can fire: the
+    // due tick of the nearest timer on level 0, or the tick a higher level
+    // first turns to an occupied slot, whichever comes first. Call it only
+    // when the wheel is not empty.
+    uint64_t next_tick() const;
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+private:
+    struct Timer {
+        uint64_t key = 0;
+        uint64_t due = 0;
+    };
+
+    void place(const Timer& timer);
+
+    // Re-places every timer of one slot of `level`, which the current tick
+    // has just reached.
+    void cascade(size_t level, size_t slot);
+
+    std::array<std::array<std::vector<Timer>, kSlots>, kLevels> slots_;
+    // Timers already due, fired by the next advance.
+    std::vector<Timer> due_;
+    uint64_t current_ = 0;
+    size_t size_ = 0;
+};